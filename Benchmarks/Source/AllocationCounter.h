@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    AllocationCounter.h
+    Created: 18 Oct 2026 8:05:52pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+
+/**
+ * Counts calls to the global operator new, replaced in Main.cpp. Allocations
+ * done with malloc, e.g. by juce::HeapBlock, are not counted.
+ *
+ */
+class AllocationCounter
+{
+public:
+  /**
+   * Records one allocation.
+   *
+   */
+  static void increment()
+  {
+    getCounter().fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Get the number of allocations since the start of the program.
+   *
+   * \return juce::int64 Number of allocations.
+   */
+  static juce::int64 getCount()
+  {
+    return getCounter().load(std::memory_order_relaxed);
+  }
+
+private:
+  /**
+   * Get the counter, constructed before any allocation.
+   *
+   * \return std::atomic<juce::int64>& Counter.
+   */
+  static std::atomic<juce::int64> &getCounter()
+  {
+    static std::atomic<juce::int64> counter{0};
+    return counter;
+  }
+};
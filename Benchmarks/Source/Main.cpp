@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026 3:40:27pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "AllocationCounter.h"
+#include "PlotBenchmark.h"
+#include "TriggerBenchmark.h"
+#include "ResamplerBenchmark.h"
+#include "PipelineBenchmark.h"
+
+//==============================================================================
+// count every allocation, see AllocationCounter
+void *operator new(std::size_t size)
+{
+  AllocationCounter::increment();
+  if (auto pointer = std::malloc(size == 0 ? 1 : size))
+  {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+//==============================================================================
+int main(int argc, char *argv[])
+{
+  // needed by the software renderer's fonts & images
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+  // --json [file]: only the pipeline benchmark, as JSON to file or stdout
+  juce::StringArray arguments(argv + 1, argc - 1);
+  auto jsonIndex = arguments.indexOf("--json");
+  if (jsonIndex >= 0)
+  {
+    auto json = juce::JSON::toString(PipelineBenchmark::run());
+    if (jsonIndex + 1 < arguments.size())
+    {
+      return juce::File::getCurrentWorkingDirectory().getChildFile(arguments[jsonIndex + 1]).replaceWithText(json) ? 0 : 1;
+    }
+    std::cout << json << std::endl;
+    return 0;
+  }
+
+  PlotBenchmark::run();
+  TriggerBenchmark::run();
+  ResamplerBenchmark::run();
+  return 0;
+}
@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+
+    PipelineBenchmark.h
+    Created: 18 Oct 2026 8:05:52pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "AllocationCounter.h"
+#include "CaptureResources.h"
+#include "DisplayHistory.h"
+#include "DisplayResampler.h"
+#include "InitVariables.h"
+#include "PeakDecimator.h"
+#include "TracePath.h"
+
+/**
+ * Drives the whole capture & render pipeline without a display.
+ *
+ * Synthetic signals go block by block through the ScopeDataCollector,
+ * triggering included, into the AudioBufferQueue. Every complete editor frame
+ * is then popped, resampled, peak-decimated and scrolled into a DisplayHistory
+ * the way OscilloscopeComponent does, and plotted into an offscreen image.
+ * Windows longer than OSCILLOSCOPE_MAX_RAW_LENGTH are rendered whole from the
+ * SummaryPyramid instead, after filling it with a window of signal.
+ *
+ * Results are machine-readable, so that runs can be compared.
+ */
+class PipelineBenchmark
+{
+public:
+  /**
+   * Runs every combination of signal, sample rate, block size and buffer
+   * length.
+   *
+   * \param secondsPerRun Seconds of audio per combination.
+   * \return juce::var JSON object with one result per combination.
+   */
+  static juce::var run(double secondsPerRun = 2.)
+  {
+    juce::Array<juce::var> results;
+    for (auto signal : {"sine", "square", "noise", "impulses"})
+    {
+      for (auto sampleRate : {44100., 96000., 192000.})
+      {
+        for (auto blockSize : {64, 512, 2048})
+        {
+          for (auto bufferLength : {0.01f, 0.2f, 1.f, 10.f, 300.f})
+          {
+            results.add(measure(signal, sampleRate, blockSize, bufferLength, secondsPerRun));
+          }
+        }
+      }
+    }
+
+    auto root = new juce::DynamicObject();
+    root->setProperty("benchmark", "pipeline");
+    root->setProperty("width", width);
+    root->setProperty("height", height);
+    root->setProperty("framesPerSecond", framesPerSecond);
+    root->setProperty("secondsPerRun", secondsPerRun);
+    root->setProperty("results", results);
+    return juce::var(root);
+  }
+
+private:
+  static constexpr int width = 1400;          /**< Width of the rendered image, i.e. displayed columns */
+  static constexpr int height = 600;          /**< Height of the rendered image */
+  static constexpr int framesPerSecond = 60;  /**< Editor refresh rate */
+
+  /**
+   * Generates a test signal.
+   *
+   * \param signal "sine", "square", "noise" or "impulses".
+   * \param sampleRate Sample rate.
+   * \param numSamples Number of samples.
+   * \return std::vector<float> Samples.
+   */
+  static std::vector<float> generate(const juce::String &signal, double sampleRate, size_t numSamples)
+  {
+    std::vector<float> data(numSamples);
+    juce::Random random(1);
+    auto impulsePeriod = (size_t)(sampleRate / 20.);
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+      auto phase = juce::MathConstants<double>::twoPi * 440. * double(i) / sampleRate;
+      if (signal == "sine")
+        data[i] = 0.5f * (float)std::sin(phase);
+      else if (signal == "square")
+        data[i] = std::sin(phase) >= 0. ? 0.5f : -0.5f;
+      else if (signal == "noise")
+        data[i] = random.nextFloat() - 0.5f;
+      else
+        data[i] = i % impulsePeriod == 0 ? 1.f : 0.f;
+    }
+    return data;
+  }
+
+  /**
+   * Get a percentile of sorted values.
+   *
+   * \param sorted Values, sorted ascending.
+   * \param percentile Percentile in [0, 100].
+   * \return double Value at the percentile, 0 if there is none.
+   */
+  static double getPercentile(const std::vector<double> &sorted, double percentile)
+  {
+    if (sorted.empty())
+    {
+      return 0.;
+    }
+    auto index = (size_t)std::round(percentile / 100. * double(sorted.size() - 1));
+    return sorted[index];
+  }
+
+  /**
+   * Runs one combination.
+   *
+   * \param signal Test signal name.
+   * \param sampleRate Sample rate.
+   * \param blockSize Samples per audio block.
+   * \param bufferLength Displayed window, in seconds.
+   * \param seconds Seconds of audio.
+   * \return juce::var JSON object with the measurements.
+   */
+  static juce::var measure(const juce::String &signal, double sampleRate, int blockSize, float bufferLength, double seconds)
+  {
+    // capture buffers, as the processor allocates them
+    CaptureResources<float>::Geometry geometry;
+    geometry.sampleRate = sampleRate;
+    geometry.blockSize = blockSize;
+    geometry.framesPerSecond = framesPerSecond;
+    CaptureResources<float>::Buffers buffers(geometry);
+    buffers.collector.setTriggerSettings(true, 0.2f, false, true, (size_t)(bufferLength * sampleRate), 0.1f, 0);
+    buffers.collector.setSilenceHold((size_t)(OSCILLOSCOPE_MAX_RAW_LENGTH() * sampleRate));
+
+    // display state, as OscilloscopeComponent sizes it
+    auto frameSize = geometry.getFrameSize();
+    auto ratio = bufferLength * sampleRate / width;
+    auto dataLength = (size_t)(frameSize / ratio);
+    auto numNew = std::min(dataLength, (size_t)width);
+    auto numRaw = std::min(frameSize, (size_t)std::ceil(numNew * ratio));
+    std::vector<float> raw(frameSize), resampled(dataLength), newMin(dataLength), newMax(dataLength);
+    std::vector<float> summaryMin((size_t)width), summaryMax((size_t)width);
+    auto isLong = bufferLength > OSCILLOSCOPE_MAX_RAW_LENGTH();
+    auto windowLength = (size_t)(bufferLength * sampleRate);
+    auto rawPointer = raw.data();
+    DisplayHistory minData, maxData;
+    minData.setSize(1, (size_t)width);
+    maxData.setSize(1, (size_t)width);
+    DisplayResampler resampler;
+    TracePath trace;
+    juce::Image image(juce::Image::ARGB, width, height, true, juce::SoftwareImageType());
+    juce::Graphics g(image);
+    auto bounds = juce::Rectangle<float>{0.f, 0.f, float(width), float(height)};
+
+    auto input = generate(signal, sampleRate, (size_t)(seconds * sampleRate));
+
+    // long windows render a full history, fed unmeasured
+    for (size_t numFed = 0; isLong && numFed < windowLength; numFed += (size_t)blockSize)
+    {
+      auto start = numFed % (input.size() - (size_t)blockSize);
+      const float *channels[] = {input.data() + start};
+      buffers.collector.process(channels, 1, (size_t)blockSize);
+      buffers.queue.flush();
+    }
+    std::vector<double> frameTimes;
+    frameTimes.reserve((size_t)(seconds * framesPerSecond) + 1);
+    juce::int64 audioTicks = 0, audioAllocations = 0, guiAllocations = 0;
+
+    for (size_t start = 0; start < input.size(); start += (size_t)blockSize)
+    {
+      // audio thread
+      auto numSamples = std::min((size_t)blockSize, input.size() - start);
+      const float *channels[] = {input.data() + start};
+      auto allocationsBefore = AllocationCounter::getCount();
+      auto ticksBefore = juce::Time::getHighResolutionTicks();
+      buffers.collector.process(channels, 1, numSamples);
+      audioTicks += juce::Time::getHighResolutionTicks() - ticksBefore;
+      audioAllocations += AllocationCounter::getCount() - allocationsBefore;
+
+      // editor frames
+      while (buffers.queue.getNumReady() >= frameSize)
+      {
+        allocationsBefore = AllocationCounter::getCount();
+        ticksBefore = juce::Time::getHighResolutionTicks();
+
+        if (isLong)
+        {
+          // raw samples are not needed, the whole window is replaced
+          buffers.queue.discard(frameSize);
+          buffers.getPyramid(0)->render(windowLength, width, summaryMin.data(), summaryMax.data());
+          minData.write(0, summaryMin.data(), (size_t)width);
+          maxData.write(0, summaryMax.data(), (size_t)width);
+        }
+        else
+        {
+          buffers.queue.pop(&rawPointer, frameSize);
+          resampler.process(raw.data(), (int)frameSize, double(frameSize - numRaw), ratio, resampled.data(), (int)numNew);
+          if (ratio < 1.)
+          {
+            minData.write(0, resampled.data(), numNew);
+            maxData.write(0, resampled.data(), numNew);
+          }
+          else
+          {
+            PeakDecimator::process(raw.data() + frameSize - numRaw, (int)numRaw, newMin.data(), newMax.data(), (int)numNew);
+            minData.write(0, newMin.data(), numNew);
+            maxData.write(0, newMax.data(), numNew);
+          }
+          minData.advance(numNew);
+          maxData.advance(numNew);
+        }
+        trace.updateEnvelope(minData.getWindow(0), maxData.getWindow(0), (size_t)width, bounds, 1.f, height / 2.f);
+        g.fillAll(juce::Colours::black);
+        g.setColour(juce::Colours::white);
+        trace.draw(g);
+
+        auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - ticksBefore);
+        guiAllocations += AllocationCounter::getCount() - allocationsBefore;
+        frameTimes.push_back(elapsed * 1000.);
+      }
+    }
+    std::sort(frameTimes.begin(), frameTimes.end());
+
+    auto result = new juce::DynamicObject();
+    result->setProperty("signal", signal);
+    result->setProperty("sampleRate", sampleRate);
+    result->setProperty("blockSize", blockSize);
+    result->setProperty("bufferLength", bufferLength);
+    result->setProperty("audioNsPerSample", juce::Time::highResolutionTicksToSeconds(audioTicks) * 1.0e9 / double(input.size()));
+    result->setProperty("audioAllocations", audioAllocations);
+    result->setProperty("frames", (int)frameTimes.size());
+    result->setProperty("frameMsP50", getPercentile(frameTimes, 50.));
+    result->setProperty("frameMsP90", getPercentile(frameTimes, 90.));
+    result->setProperty("frameMsP99", getPercentile(frameTimes, 99.));
+    result->setProperty("frameMsMax", frameTimes.empty() ? 0. : frameTimes.back());
+    result->setProperty("guiAllocations", guiAllocations);
+    return juce::var(result);
+  }
+};
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    PlotBenchmark.h
+    Created: 18 Oct 2026 3:40:27pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "TracePath.h"
+
+/**
+ * Compares painting a trace with one Graphics::drawLine per sample against
+ * painting a TracePath rebuilt once per frame.
+ *
+ */
+class PlotBenchmark
+{
+public:
+  /**
+   * Runs the benchmark for several numbers of points and prints the results.
+   *
+   * \param numIterations Number of painted frames per measurement.
+   */
+  static void run(int numIterations = 200)
+  {
+    std::cout << "plot benchmark (" << numIterations << " frames, " << width << "x" << height << ")" << std::endl;
+    std::cout << "points\tdrawLine ms/frame\tbuild ms/frame\tpaint ms/frame\tspeedup" << std::endl;
+
+    for (auto numPoints : {350, 1400, 2800, 5600})
+    {
+      // one period of a sine plus some harmonics
+      std::vector<float> data((size_t)numPoints);
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        auto phase = juce::MathConstants<float>::twoPi * float(i) / float(numPoints);
+        data[i] = 0.6f * std::sin(phase) + 0.2f * std::sin(7.f * phase) + 0.1f * std::sin(31.f * phase);
+      }
+
+      auto legacy = measure(numIterations, [&](juce::Graphics &g)
+                            { paintWithDrawLine(g, data); });
+
+      TracePath trace;
+      auto build = measure(numIterations, [&](juce::Graphics &)
+                           { trace.updateLine(data.data(), data.size(), getBounds(), 1.f, height / 2.f); });
+      auto paint = measure(numIterations, [&](juce::Graphics &g)
+                           { trace.draw(g); });
+
+      std::cout << numPoints << "\t" << legacy << "\t" << build << "\t" << paint << "\t" << legacy / std::max(paint, 1e-9) << "x" << std::endl;
+    }
+  }
+
+private:
+  static constexpr int width = 1400;  /**< Width of the rendered image */
+  static constexpr int height = 600;  /**< Height of the rendered image */
+
+  /**
+   * Get the plotting area.
+   *
+   * \return juce::Rectangle<float> Plotting area.
+   */
+  static juce::Rectangle<float> getBounds()
+  {
+    return {0.f, 0.f, float(width), float(height)};
+  }
+
+  /**
+   * Paints data the way the oscilloscopes used to, with one drawLine and two
+   * jmap calls per sample.
+   *
+   * \param g <a href="https://docs.juce.com/master/classGraphics.html">JUCE Graphics </a>
+   * \param data Samples to paint.
+   */
+  static void paintWithDrawLine(juce::Graphics &g, const std::vector<float> &data)
+  {
+    auto center = height / 2.f;
+    auto gain = float(height);
+    for (size_t i = 1; i < data.size(); ++i)
+    {
+      g.drawLine({juce::jmap(float(i - 1), 0.f, float(data.size() - 1), 0.f, float(width)),
+                  center - gain * data[i - 1],
+                  juce::jmap(float(i), 0.f, float(data.size() - 1), 0.f, float(width)),
+                  center - gain * data[i]});
+    }
+  }
+
+  /**
+   * Measures the average time of a painting function.
+   *
+   * \param numIterations Number of calls.
+   * \param function Function painting into the given Graphics.
+   * \return double Milliseconds per call.
+   */
+  template <typename Function>
+  static double measure(int numIterations, Function &&function)
+  {
+    juce::Image image(juce::Image::ARGB, width, height, true, juce::SoftwareImageType());
+    juce::Graphics g(image);
+    g.setColour(juce::Colours::beige);
+
+    auto start = juce::Time::getHighResolutionTicks();
+    for (int i = 0; i < numIterations; ++i)
+    {
+      function(g);
+    }
+    auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    return elapsed * 1000. / numIterations;
+  }
+};
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    ResamplerBenchmark.h
+    Created: 18 Oct 2026 9:41:05pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "DisplayResampler.h"
+
+/**
+ * Measures the cost and the accuracy of each DisplayResampler engine when a
+ * display zooms in on a sine close to Nyquist.
+ *
+ * Accuracy is the largest difference between the reconstructed waveform and
+ * the analytic sine, away from the edges where samples are clamped.
+ */
+class ResamplerBenchmark
+{
+public:
+  /**
+   * Runs the benchmark for several zoom factors and prints the results.
+   *
+   * \param numIterations Number of resampled windows per measurement.
+   */
+  static void run(int numIterations = 2000)
+  {
+    std::cout << "resampler benchmark (" << numColumns << " columns, sine at " << frequency << " of the sample rate)" << std::endl;
+    std::cout << "samples\tengine\tus/window\tmax error" << std::endl;
+
+    const char *names[] = {"linear", "cubic", "sinc"};
+    for (auto numSamples : {700, 350, 88})
+    {
+      std::vector<float> input((size_t)numSamples), output((size_t)numColumns);
+      for (size_t i = 0; i < input.size(); ++i)
+      {
+        input[i] = std::sin(juce::MathConstants<float>::twoPi * frequency * float(i));
+      }
+      auto step = double(numSamples) / numColumns;
+
+      for (int engine = 0; engine < 3; ++engine)
+      {
+        DisplayResampler resampler;
+        resampler.setEngine((DisplayResampler::Engine)engine);
+
+        auto start = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < numIterations; ++i)
+        {
+          resampler.process(input.data(), numSamples, 0., step, output.data(), numColumns);
+        }
+        auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        // error away from the clamped edges
+        double error = 0.;
+        for (int column = 0; column < numColumns; ++column)
+        {
+          auto position = column * step;
+          if (position < DisplayResampler::numTaps || position > numSamples - DisplayResampler::numTaps)
+          {
+            continue;
+          }
+          auto expected = std::sin(juce::MathConstants<double>::twoPi * frequency * position);
+          error = std::max(error, std::abs(output[(size_t)column] - expected));
+        }
+
+        std::cout << numSamples << "\t" << names[engine] << "\t" << elapsed * 1000000. / numIterations << "\t" << error << std::endl;
+      }
+    }
+  }
+
+private:
+  static constexpr int numColumns = 1400;     /**< Displayed columns */
+  static constexpr double frequency = 0.4;    /**< Sine frequency over the sample rate */
+};
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+    TriggerBenchmark.h
+    Created: 18 Oct 2026 6:17:40pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "CrossingSearch.h"
+
+/**
+ * Compares the trigger search of automatic mode as done by the former
+ * FindMethods (vector copy, max_element, then a scalar walk), as done by the
+ * scalar TriggerDetector (findMinAndMax, then a scalar walk) and as done by
+ * the fused vectorised CrossingSearch kernel.
+ *
+ * Every path searches for the same threshold, as automatic mode derives it
+ * from the peak of the previous blocks, and scans the window for its peak.
+ * The signal never reaches the threshold, so every search reads the whole
+ * window, which is the worst case of the audio thread.
+ */
+class TriggerBenchmark
+{
+public:
+  /**
+   * Runs the benchmark for windows of one second at several sample rates and
+   * prints the results.
+   *
+   * \param numIterations Number of searches per measurement.
+   */
+  static void run(int numIterations = 500)
+  {
+    std::cout << "trigger benchmark (" << numIterations << " searches, threshold " << searchThreshold << ")" << std::endl;
+    std::cout << "samples\tlegacy us/search\tscalar us/search\tvectorised us/search\tspeedup" << std::endl;
+
+    for (auto numSamples : {48000, 96000, 192000})
+    {
+      // a sine and some noise, always below the threshold
+      juce::Random random(1);
+      std::vector<float> data((size_t)numSamples);
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        auto phase = juce::MathConstants<float>::twoPi * 440.f * float(i) / float(numSamples);
+        data[i] = 0.5f * std::sin(phase) + 0.05f * (random.nextFloat() - 0.5f);
+      }
+
+      auto legacy = measure(numIterations, [&]
+                            { return searchLegacy(data, searchThreshold); });
+      auto scalar = measure(numIterations, [&]
+                            { return searchScalar(data.data(), numSamples, searchThreshold); });
+      auto vectorised = measure(numIterations, [&]
+                                { return CrossingSearch<float>::findWithMaximum<false>(data.data(), numSamples, searchThreshold, 0.f); });
+
+      std::cout << numSamples << "\t" << legacy << "\t" << scalar << "\t" << vectorised << "\t" << scalar / std::max(vectorised, 1e-9) << "x" << std::endl;
+    }
+  }
+
+private:
+  static constexpr float searchThreshold = 0.9f; /**< Level to cross, never reached by the signal */
+
+  /**
+   * Searches the way FindMethods used to, taking the window by value and
+   * scanning it once for the peak and once for the crossing.
+   *
+   * \param data Window to search.
+   * \param threshold Level to cross.
+   * \return CrossingSearch<float>::Result First crossing & peak.
+   */
+  static CrossingSearch<float>::Result searchLegacy(std::vector<float> data, float threshold)
+  {
+    auto peak = *std::max_element(data.begin(), data.end());
+    auto crosses = [threshold](float previous, float current)
+    { return previous < threshold && current >= threshold; };
+
+    for (size_t i = 1; i < data.size(); ++i)
+    {
+      if (crosses(data[i - 1], data[i]))
+      {
+        return {(int)i, peak};
+      }
+    }
+    return {-1, peak};
+  }
+
+  /**
+   * Searches the way TriggerDetector used to, with a vectorised peak scan and
+   * a scalar crossing scan.
+   *
+   * \param data Window to search.
+   * \param numSamples Number of samples.
+   * \param threshold Level to cross.
+   * \return CrossingSearch<float>::Result First crossing & peak.
+   */
+  static CrossingSearch<float>::Result searchScalar(const float *data, int numSamples, float threshold)
+  {
+    auto peak = juce::FloatVectorOperations::findMinAndMax(data, numSamples).getEnd();
+    auto previous = 0.f;
+    for (int i = 0; i < numSamples; ++i)
+    {
+      if (previous < threshold && data[i] >= threshold)
+      {
+        return {i, peak};
+      }
+      previous = data[i];
+    }
+    return {-1, peak};
+  }
+
+  /**
+   * Measures the average time of a search function.
+   *
+   * \param numIterations Number of calls.
+   * \param function Function returning the found crossing & peak.
+   * \return double Microseconds per call.
+   */
+  template <typename Function>
+  static double measure(int numIterations, Function &&function)
+  {
+    int found = 0;
+    float peaks = 0.f;
+    auto start = juce::Time::getHighResolutionTicks();
+    for (int i = 0; i < numIterations; ++i)
+    {
+      auto result = function();
+      found += result.index;
+      peaks += result.maximum;
+    }
+    auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+    // keeps the searches from being optimised away
+    static volatile int sink;
+    static volatile float peakSink;
+    sink = found;
+    peakSink = peaks;
+    return elapsed * 1000000. / numIterations;
+  }
+};
@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    ActivityDetector.h
+    Created: 18 Oct 2026 11:02:51pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <atomic>
+
+/**
+ * Per-block peak detector telling whether the captured signal is silent.
+ *
+ * The signal goes quiet once every block stayed below the sleep level for a
+ * hold time, long enough for the last sounds to scroll out of any raw
+ * window. A single block above the wake level ends it at once. The wake
+ * level being above the sleep level, noise around either of them does not
+ * toggle the state block after block.
+ *
+ * Written by the audio thread, readable from any thread.
+ */
+template <typename SampleType>
+class ActivityDetector
+{
+public:
+    //==============================================================================
+    static constexpr SampleType sleepLevel = SampleType(1.0e-5); /**< Peak below which an active signal counts as silent, about -100 dBFS */
+    static constexpr SampleType wakeLevel = SampleType(3.0e-5);  /**< Peak above which a quiet signal is active again, about -90 dBFS */
+
+    /**
+     * Sets how long the signal must stay silent before going quiet. To be
+     * called from the audio thread.
+     *
+     * \param numSamples Hold time in samples.
+     */
+    void setHoldLength(size_t numSamples)
+    {
+        holdLength.store(numSamples, std::memory_order_relaxed);
+    }
+
+    /**
+     * Forgets the past signal, which counts as active again. To be called from
+     * the audio thread.
+     *
+     */
+    void reset()
+    {
+        numSilentSamples.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Analyses a block.
+     *
+     * \param data Pointers to the samples of each channel.
+     * \param numChannels Number of channels.
+     * \param numSamples Number of samples per channel.
+     * \return true if the signal is quiet after this block.
+     * \return false otherwise.
+     */
+    bool process(const SampleType *const *data, int numChannels, size_t numSamples)
+    {
+        // peak of all channels
+        SampleType peak = 0;
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto range = juce::FloatVectorOperations::findMinAndMax(data[channel], (int)numSamples);
+            peak = std::max(peak, std::max(-range.getStart(), range.getEnd()));
+        }
+
+        // hysteresis between the two levels
+        auto silentSamples = numSilentSamples.load(std::memory_order_relaxed);
+        auto hold = holdLength.load(std::memory_order_relaxed);
+        auto quiet = silentSamples >= hold;
+        if (peak >= (quiet ? wakeLevel : sleepLevel))
+        {
+            numSilentSamples.store(0, std::memory_order_relaxed);
+            if (quiet)
+            {
+                numWakes.fetch_add(1, std::memory_order_release);
+            }
+            return false;
+        }
+
+        numSilentSamples.store(silentSamples + numSamples, std::memory_order_relaxed);
+        return silentSamples + numSamples >= hold;
+    }
+
+    /**
+     * Returns whether the signal went quiet. Safe from any thread.
+     *
+     * \return true if it stayed silent for the hold time.
+     * \return false otherwise.
+     */
+    bool isQuiet() const
+    {
+        return numSilentSamples.load(std::memory_order_relaxed) >= holdLength.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get for how long the signal has been silent. Safe from any thread.
+     *
+     * \return juce::uint64 Consecutive silent samples up to the last block.
+     */
+    juce::uint64 getNumSilentSamples() const
+    {
+        return numSilentSamples.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get for how long the signal has been quiet. Safe from any thread.
+     *
+     * \return juce::uint64 Silent samples past the hold time, 0 while active.
+     */
+    juce::uint64 getNumQuietSamples() const
+    {
+        auto silentSamples = numSilentSamples.load(std::memory_order_relaxed);
+        auto hold = (juce::uint64)holdLength.load(std::memory_order_relaxed);
+        return silentSamples > hold ? silentSamples - hold : 0;
+    }
+
+    /**
+     * Get the number of times a quiet signal became active. Safe from any
+     * thread; a change tells that the signal just woke up.
+     *
+     * \return juce::uint32 Wake-up counter.
+     */
+    juce::uint32 getNumWakes() const
+    {
+        return numWakes.load(std::memory_order_acquire);
+    }
+
+private:
+    //==============================================================================
+    std::atomic<juce::uint64> numSilentSamples{0}; /**< Consecutive silent samples */
+    std::atomic<juce::uint32> numWakes{0};         /**< Times a quiet signal became active */
+    std::atomic<size_t> holdLength{0};             /**< Silent samples before going quiet */
+};
@@ -11,8 +11,18 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <atomic>
+#include <cstring>
+
 /**
- * A Fifo queue of buffers working with data of SampleType type.
+ * A single producer, single consumer lock-free ring of multi-channel samples of
+ * SampleType type.
+ *
+ * The audio thread pushes blocks of any size and the GUI pops windows of any
+ * size. Channels are stored planar in one contiguous, cache-aligned allocation
+ * whose per-channel capacity is a power of two, so every read or write is at
+ * most two memcpy spans per channel. All channels share the same indices and
+ * therefore always stay sample-aligned.
  */
 template <typename SampleType>
 class AudioBufferQueue
@@ -23,88 +33,166 @@ public:
     /**
      * Constructor.
      *
-     * \param newBufferSize Buffer size.
+     * \param hostRate Host sample rate.
+     * \param editorFramesPerSecond Editor refresh rate.
+     * \param numSamplesPerBlock Maximum number of samples per audio block.
+     * \param numChannelsToUse Number of channels.
      */
-    AudioBufferQueue(int hostRate = 44100, int editorFramesPerSecond = 30, int numSamplesPerBlock = 441)
+    AudioBufferQueue(int hostRate = 44100, int editorFramesPerSecond = 30, int numSamplesPerBlock = 441, int numChannelsToUse = 1)
+        : numChannels(std::max(numChannelsToUse, 1))
     {
         // set number of samples per frame
-        this->bufferSize = hostRate / editorFramesPerSecond;
-
-        // calculate capacitz and reset buffers & Abstract FIFO
-        int capacity = numSamplesPerBlock * 2;
-        numBuffers = std::max((int)(capacity / bufferSize + 1), (int)5);
-        abstractFifo.reset(new juce::AbstractFifo(numBuffers));
-        buffers.resize(numBuffers);
-        for (size_t i = 0; i < numBuffers; i++)
+        this->bufferSize = (size_t)(hostRate / editorFramesPerSecond);
+
+        // calculate capacity, rounded up to a power of two so that indices can be masked
+        auto minCapacity = std::max(bufferSize * numFramesToBuffer, (size_t)numSamplesPerBlock * 4);
+        capacity = 1;
+        while (capacity < minCapacity)
         {
-            buffers[i].resize(bufferSize);
+            capacity <<= 1;
         }
+        mask = capacity - 1;
+
+        // allocate planar storage aligned to a cache line
+        storage.calloc(capacity * (size_t)numChannels * sizeof(SampleType) + cacheLineSize);
+        auto address = reinterpret_cast<uintptr_t>(storage.get());
+        samples = reinterpret_cast<SampleType *>((address + cacheLineSize - 1) & ~(uintptr_t)(cacheLineSize - 1));
     }
 
     /**
-     * Pushes a buffer of data.
+     * Pushes a block of data. To be called from the audio thread only.
      *
-     * \param dataToPush Data to push to the buffers
-     * \param numSamples Number of samples
+     * If the consumer fell behind, only the samples that fit are written and
+     * the rest is dropped. Channels of the queue beyond numChannelsToPush are
+     * filled with silence.
+     *
+     * \param dataToPush Data to push to the queue, one pointer per channel.
+     * \param numChannelsToPush Number of channels in dataToPush.
+     * \param numSamples Number of samples per channel.
+     * \return size_t Number of samples actually written.
      */
-    void push(const SampleType *dataToPush, size_t numSamples)
+    size_t push(const SampleType *const *dataToPush, int numChannelsToPush, size_t numSamples)
     {
-        // no more samples than buffer size
-        jassert(numSamples <= bufferSize);
-
-        // get pointer to where to write
-        int start1, size1 = 0, start2, size2;
-        abstractFifo->prepareToWrite(1, start1, size1, start2, size2);
+        // get where and how much to write
+        auto write = writeIndex.load(std::memory_order_relaxed);
+        auto read = readIndex.load(std::memory_order_acquire);
+        auto numToWrite = std::min(numSamples, capacity - (write - read));
+
+        // write each channel in at most two spans
+        auto start = write & mask;
+        auto size1 = std::min(numToWrite, capacity - start);
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto destination = getChannel(channel);
+            if (channel < numChannelsToPush)
+            {
+                std::memcpy(destination + start, dataToPush[channel], size1 * sizeof(SampleType));
+                std::memcpy(destination, dataToPush[channel] + size1, (numToWrite - size1) * sizeof(SampleType));
+            }
+            else
+            {
+                std::fill(destination + start, destination + start + size1, SampleType(0));
+                std::fill(destination, destination + numToWrite - size1, SampleType(0));
+            }
+        }
 
-        jassert(size1 <= 1);
-        jassert(size2 == 0);
+        writeIndex.store(write + numToWrite, std::memory_order_release);
+        return numToWrite;
+    }
 
-        // write data
-        if (size1 > 0)
+    /**
+     * Pushes a block of silence. To be called from the audio thread only.
+     *
+     * \param numSamples Number of samples.
+     * \return size_t Number of samples actually written.
+     */
+    size_t pushSilence(size_t numSamples)
+    {
+        // get where and how much to write
+        auto write = writeIndex.load(std::memory_order_relaxed);
+        auto read = readIndex.load(std::memory_order_acquire);
+        auto numToWrite = std::min(numSamples, capacity - (write - read));
+
+        // clear each channel in at most two spans
+        auto start = write & mask;
+        auto size1 = std::min(numToWrite, capacity - start);
+        for (int channel = 0; channel < numChannels; ++channel)
         {
-            juce::FloatVectorOperations::copy(buffers[(size_t)start1].data(), dataToPush, numSamples);
+            auto destination = getChannel(channel);
+            std::fill(destination + start, destination + start + size1, SampleType(0));
+            std::fill(destination, destination + numToWrite - size1, SampleType(0));
         }
 
-        abstractFifo->finishedWrite(size1);
+        writeIndex.store(write + numToWrite, std::memory_order_release);
+        return numToWrite;
     }
 
     //==============================================================================
     /**
-     * Pops a buffer of data.
+     * Pops a window of data. To be called from the GUI thread only.
      *
-     * \param outputBuffer output buffer
+     * \param outputBuffers Output buffers, one per channel of the queue, each
+     * at least numSamples long.
+     * \param numSamples Number of samples wanted per channel.
+     * \return size_t Number of samples actually read (less than numSamples if not
+     * enough data is ready).
      */
-    void pop(SampleType *outputBuffer)
+    size_t pop(SampleType *const *outputBuffers, size_t numSamples)
     {
-        // get where to read
-        int start1, size1, start2, size2;
-        abstractFifo->prepareToRead(1, start1, size1, start2, size2);
-
-        jassert(size1 <= 1);
-        jassert(size2 == 0);
+        // get where and how much to read
+        auto read = readIndex.load(std::memory_order_relaxed);
+        auto write = writeIndex.load(std::memory_order_acquire);
+        auto numToRead = std::min(numSamples, write - read);
+
+        // read each channel in at most two spans
+        auto start = read & mask;
+        auto size1 = std::min(numToRead, capacity - start);
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto source = getChannel(channel);
+            std::memcpy(outputBuffers[channel], source + start, size1 * sizeof(SampleType));
+            std::memcpy(outputBuffers[channel] + size1, source, (numToRead - size1) * sizeof(SampleType));
+        }
 
-        // read
-        if (size1 > 0)
-            juce::FloatVectorOperations::copy(outputBuffer, buffers[(size_t)start1].data(), (int)buffers[(size_t)start1].size());
+        readIndex.store(read + numToRead, std::memory_order_release);
+        return numToRead;
+    }
 
-        abstractFifo->finishedRead(size1);
+    /**
+     * Discards up to numSamples of the oldest ready samples. To be called from
+     * the GUI thread only.
+     *
+     * \param numSamples Number of samples to discard.
+     */
+    void discard(size_t numSamples)
+    {
+        auto read = readIndex.load(std::memory_order_relaxed);
+        auto write = writeIndex.load(std::memory_order_acquire);
+        readIndex.store(read + std::min(numSamples, write - read), std::memory_order_release);
     }
 
     /**
-     * Empties all buffers.
+     * Empties the queue, discarding every ready sample. To be called from the
+     * GUI thread only.
      *
      */
     void flush()
     {
-        // fill every buffer with 0
-        for (auto i = 0; i < numBuffers; i++)
-        {
-            std::fill(std::begin(buffers[i]), std::end(buffers[i]), 0);
-        }
+        readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    /**
+     * Get the number of samples ready to be popped.
+     *
+     * \return size_t Number of samples ready.
+     */
+    size_t getNumReady() const
+    {
+        return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire);
     }
 
     /**
-     * Get buffer size.
+     * Get buffer size, i.e. the number of samples produced during one editor frame.
      *
      * \return Buffer size.
      */
@@ -113,10 +201,49 @@ public:
         return bufferSize;
     }
 
+    /**
+     * Get the number of channels.
+     *
+     * \return int Number of channels.
+     */
+    int getNumChannels() const
+    {
+        return numChannels;
+    }
+
+    /**
+     * Get the capacity of the queue in samples per channel.
+     *
+     * \return size_t Capacity (always a power of two).
+     */
+    size_t getCapacity() const
+    {
+        return capacity;
+    }
+
 private:
     //==============================================================================
-    size_t numBuffers = 5;                            /**< Number of buffers */
-    std::unique_ptr<juce::AbstractFifo> abstractFifo; /**<a href = "https://docs.juce.com/master/classAbstractFifo.html">Abstract Fifo< / a> */
-    std::vector<std::vector<SampleType>> buffers;     /**< Array of buffers */
-    size_t bufferSize;                                /**< Buffer size */
-};
\ No newline at end of file
+    static constexpr size_t cacheLineSize = 64;    /**< Alignment of storage and indices */
+    static constexpr size_t numFramesToBuffer = 8; /**< Minimum number of editor frames the queue can hold */
+
+    /**
+     * Get the start of a channel's ring.
+     *
+     * \param channel Channel index.
+     * \return SampleType* Channel ring.
+     */
+    SampleType *getChannel(int channel)
+    {
+        return samples + (size_t)channel * capacity;
+    }
+
+    juce::HeapBlock<char> storage;       /**< Raw allocation, padded for alignment */
+    SampleType *samples = nullptr;       /**< Cache-aligned start of the ring */
+    size_t capacity = 0;                 /**< Ring capacity in samples per channel (power of two) */
+    size_t mask = 0;                     /**< capacity - 1 */
+    size_t bufferSize;                   /**< Samples per editor frame */
+    int numChannels;                     /**< Number of channels */
+
+    alignas(cacheLineSize) std::atomic<size_t> writeIndex{0}; /**< Total samples written, owned by the producer */
+    alignas(cacheLineSize) std::atomic<size_t> readIndex{0};  /**< Total samples read, owned by the consumer */
+};
@@ -0,0 +1,314 @@
+/*
+  ==============================================================================
+
+    CaptureEngine.h
+    Created: 18 Oct 2026 2:05:41pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TriggerDetector.h"
+#include "TriggeredFrameBuffer.h"
+
+/**
+ * Bench-scope style acquisition engine.
+ *
+ * Keeps a circular pre-trigger history of every input channel. On each
+ * trigger crossing of the first channel it waits for the post-trigger samples,
+ * then copies the whole trigger-aligned frame of all channels into the
+ * TriggeredFrameBuffer and publishes it. After that it ignores crossings until
+ * the holdoff time has elapsed and then rearms.
+ */
+template <typename SampleType>
+class CaptureEngine
+{
+public:
+    //==============================================================================
+    /**
+     * Constructor. Allocates the history, so it must not be called on the audio thread.
+     *
+     * \param framesToUse Where to publish acquisitions.
+     */
+    CaptureEngine(TriggeredFrameBuffer<SampleType> &framesToUse)
+        : triggeredFrames(framesToUse), numChannels(framesToUse.getNumChannels())
+    {
+        // history must hold a full frame plus the chunk being processed
+        historySize = 1;
+        while (historySize < triggeredFrames.getMaxFrameLength() + maxChunkSize)
+        {
+            historySize <<= 1;
+        }
+        history.calloc(historySize * (size_t)numChannels);
+    }
+
+    /**
+     * Sets acquisition settings. To be called from the audio thread.
+     *
+     * \param level Trigger level.
+     * \param isFalling Whether to trigger on decrescent slope.
+     * \param isAutomatic Whether the level is relative to the signal peak.
+     * \param newFrameLength Samples per acquisition.
+     * \param preTriggerRatio Fraction of each acquisition taken before the crossing.
+     * \param newHoldoffLength Minimum samples between two crossings.
+     */
+    void setSettings(SampleType level, bool isFalling, bool isAutomatic, size_t newFrameLength, float preTriggerRatio, size_t newHoldoffLength)
+    {
+        triggerDetector.setLevel(level);
+        triggerDetector.setFalling(isFalling);
+        triggerDetector.setAutomatic(isAutomatic);
+        frameLength = juce::jlimit((size_t)2, triggeredFrames.getMaxFrameLength(), newFrameLength);
+        preTriggerLength = (size_t)(juce::jlimit(0.f, 1.f, preTriggerRatio) * (float)(frameLength - 1));
+        holdoffLength = newHoldoffLength;
+    }
+
+    /**
+     * Drops the acquisition in progress and rearms.
+     *
+     */
+    void rearm()
+    {
+        state = State::armed;
+    }
+
+    /**
+     * Forgets the stream history and rearms. To be called from the audio thread.
+     * No frame is taken until the pre-trigger part of it holds samples appended
+     * after the reset, so the stale history is never published.
+     *
+     */
+    void reset()
+    {
+        triggerDetector.reset();
+        historyStart = numWritten;
+        rearm();
+    }
+
+    /**
+     * Get the number of acquisitions published so far.
+     *
+     * \return juce::uint64 Number of triggers.
+     */
+    juce::uint64 getNumTriggers() const
+    {
+        return numTriggers;
+    }
+
+    //==============================================================================
+    /**
+     * Processes incoming data. The first channel is the trigger source.
+     *
+     * \param data pointers to a series of data, one per channel.
+     * \param numChannelsToProcess number of channels in data.
+     * \param numSamples number of samples in the series.
+     */
+    void process(const SampleType *const *data, int numChannelsToProcess, size_t numSamples)
+    {
+        // go through chunks the history can always hold with a full frame
+        size_t startSample = 0;
+        while (startSample < numSamples)
+        {
+            auto chunk = std::min(numSamples - startSample, maxChunkSize);
+            processChunk(data, numChannelsToProcess, startSample, (int)chunk);
+            startSample += chunk;
+        }
+    }
+
+private:
+    //==============================================================================
+    /**
+     * Appends a chunk to the history and advances the acquisition state machine.
+     *
+     * \param input pointers to a series of data, one per channel.
+     * \param numInputChannels number of channels in input.
+     * \param startSample first sample of the chunk in the series.
+     * \param numSamples number of samples in the chunk.
+     */
+    void processChunk(const SampleType *const *input, int numInputChannels, size_t startSample, int numSamples)
+    {
+        // append every channel to history in at most two spans, missing channels are silent
+        auto chunkStart = numWritten;
+        auto start = (size_t)(numWritten & (historySize - 1));
+        auto size1 = std::min((size_t)numSamples, historySize - start);
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto channelHistory = getHistory(channel);
+            if (channel < numInputChannels)
+            {
+                auto channelData = input[channel] + startSample;
+                std::copy(channelData, channelData + size1, channelHistory + start);
+                std::copy(channelData + size1, channelData + numSamples, channelHistory);
+            }
+            else
+            {
+                std::fill(channelHistory + start, channelHistory + start + size1, SampleType(0));
+                std::fill(channelHistory, channelHistory + numSamples - size1, SampleType(0));
+            }
+        }
+        numWritten += (juce::uint64)numSamples;
+
+        // the first channel is the trigger source
+        if (numInputChannels < 1)
+        {
+            return;
+        }
+        auto data = input[0] + startSample;
+        triggerDetector.visitMode([&](auto falling, auto automatic)
+                                  { advance<decltype(falling)::value, decltype(automatic)::value>(data, numSamples, chunkStart); });
+        triggerDetector.endBlock(data, numSamples);
+    }
+
+    /**
+     * Searches a chunk of the trigger source and advances the acquisition
+     * state machine.
+     *
+     * \tparam falling Trigger slope.
+     * \tparam automatic Whether the level is relative to the signal peak.
+     * \param data Trigger source samples of the chunk.
+     * \param numSamples Number of samples in the chunk.
+     * \param chunkStart Absolute position of the first sample of the chunk.
+     */
+    template <bool falling, bool automatic>
+    void advance(const SampleType *data, int numSamples, juce::uint64 chunkStart)
+    {
+        triggerDetector.template analyseBlock<falling, automatic>(data, numSamples);
+
+        int index = 0;
+        while (index < numSamples)
+        {
+            if (state == State::armed)
+            {
+                // skip crossings whose pre-trigger samples precede the reset
+                auto firstValid = historyStart + (juce::uint64)preTriggerLength;
+                if (firstValid > chunkStart + (juce::uint64)index)
+                {
+                    if (firstValid >= chunkStart + (juce::uint64)numSamples)
+                    {
+                        break;
+                    }
+                    index = (int)(firstValid - chunkStart);
+                }
+
+                // look for a crossing
+                double crossingOffset;
+                auto crossing = triggerDetector.template findCrossing<falling>(data, numSamples, index, crossingOffset);
+                if (crossing < 0)
+                {
+                    break;
+                }
+
+                // setup acquisition around it
+                triggerPosition = chunkStart + (juce::uint64)crossing;
+                currentCrossingOffset = crossingOffset;
+                currentFrameLength = frameLength;
+                currentPreTriggerLength = preTriggerLength;
+                rearmPosition = triggerPosition + std::max((juce::uint64)(currentFrameLength - currentPreTriggerLength), (juce::uint64)holdoffLength);
+                state = State::collecting;
+                index = crossing;
+            }
+
+            if (state == State::collecting)
+            {
+                // wait for the post-trigger samples
+                auto frameEnd = triggerPosition + (currentFrameLength - currentPreTriggerLength);
+                if (frameEnd > numWritten)
+                {
+                    break;
+                }
+
+                publishFrame(frameEnd);
+                state = State::holdoff;
+            }
+
+            if (state == State::holdoff)
+            {
+                // ignore crossings until the holdoff has elapsed
+                if (rearmPosition >= numWritten)
+                {
+                    break;
+                }
+
+                if (rearmPosition > chunkStart)
+                {
+                    index = std::max(index, (int)(rearmPosition - chunkStart));
+                }
+                state = State::armed;
+            }
+        }
+    }
+
+    /**
+     * Copies the acquisition ending at frameEnd from the history and publishes it.
+     *
+     * \param frameEnd Absolute position of the sample after the last one of the frame.
+     */
+    void publishFrame(juce::uint64 frameEnd)
+    {
+        auto &frame = triggeredFrames.getWriteFrame();
+        auto frameStart = frameEnd - currentFrameLength;
+
+        // copy every channel in at most two spans
+        auto start = (size_t)(frameStart & (historySize - 1));
+        auto size1 = std::min(currentFrameLength, historySize - start);
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto channelHistory = getHistory(channel);
+            auto channelFrame = frame.getChannel(channel);
+            std::copy(channelHistory + start, channelHistory + start + size1, channelFrame);
+            std::copy(channelHistory, channelHistory + currentFrameLength - size1, channelFrame + size1);
+        }
+
+        frame.numSamples = currentFrameLength;
+        frame.triggerIndex = currentPreTriggerLength;
+        frame.crossingOffset = currentCrossingOffset;
+        triggeredFrames.publish();
+        ++numTriggers;
+    }
+
+    /**
+     * Get the history of a channel.
+     *
+     * \param channel Channel index.
+     * \return SampleType* Channel history.
+     */
+    SampleType *getHistory(int channel)
+    {
+        return history.get() + (size_t)channel * historySize;
+    }
+
+    //==============================================================================
+    static constexpr size_t maxChunkSize = 4096; /**< Largest chunk processed at once */
+
+    TriggeredFrameBuffer<SampleType> &triggeredFrames; /**< Where acquisitions are published */
+    TriggerDetector<SampleType> triggerDetector;       /**< Finds trigger crossings */
+
+    int numChannels;                     /**< Channels captured */
+    juce::HeapBlock<SampleType> history; /**< Circular pre-trigger history, planar */
+    size_t historySize = 0;              /**< History size per channel (power of two) */
+    juce::uint64 numWritten = 0;         /**< Total samples appended to history */
+    juce::uint64 historyStart = 0;       /**< Absolute position of the first sample appended since the last reset */
+
+    size_t frameLength = 2;      /**< Samples per acquisition */
+    size_t preTriggerLength = 0; /**< Samples before the crossing */
+    size_t holdoffLength = 0;    /**< Minimum samples between crossings */
+
+    juce::uint64 triggerPosition = 0;   /**< Absolute position of the first sample after the crossing */
+    juce::uint64 rearmPosition = 0;     /**< Absolute position where the engine rearms */
+    double currentCrossingOffset = 0.;  /**< Sub-sample offset of the current crossing */
+    size_t currentFrameLength = 2;      /**< Length of the current acquisition */
+    size_t currentPreTriggerLength = 0; /**< Pre-trigger length of the current acquisition */
+    juce::uint64 numTriggers = 0;       /**< Acquisitions published so far */
+
+    /**
+     * States of the class.
+     */
+    enum class State
+    {
+        armed,
+        collecting,
+        holdoff
+    } state{State::armed};
+};
@@ -0,0 +1,340 @@
+/*
+  ==============================================================================
+
+    CaptureResources.h
+    Created: 18 Oct 2026 7:02:13pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "ScopeDataCollector.h"
+
+/**
+ * Owner of every capture buffer shared by the audio and GUI threads.
+ *
+ * Buffers are allocated once for a capacity, i.e. a channel count, a maximum
+ * sample rate and a maximum block size, so that reconfiguring within it only
+ * publishes a new geometry. Each configuration is an immutable @ref State
+ * swapped in atomically and tagged with an increasing epoch.
+ *
+ * The audio thread picks up the current State at the start of each block and
+ * clears the buffers on the first block of a new epoch. Each GUI reader
+ * acquires the current State once per frame and announces the epoch it uses
+ * in a slot of its own, so a replaced State, and the buffers only it refers
+ * to, is freed by @ref prepare only once it is older than every announced
+ * epoch. Neither thread ever waits for the other.
+ */
+template <typename SampleType>
+class CaptureResources
+{
+public:
+    //==============================================================================
+    /**
+     * Capture configuration.
+     */
+    struct Geometry
+    {
+        double sampleRate = 44100.;  /**< Host sample rate */
+        int blockSize = 441;         /**< Maximum samples per audio block */
+        int numChannels = 1;         /**< Captured channels */
+        int framesPerSecond = 30;    /**< Editor refresh rate */
+
+        /**
+         * Get the number of samples produced during one editor frame.
+         *
+         * \return size_t Samples per editor frame.
+         */
+        size_t getFrameSize() const
+        {
+            return (size_t)(sampleRate / framesPerSecond);
+        }
+    };
+
+    /**
+     * One allocation of every capture buffer.
+     */
+    struct Buffers
+    {
+        /**
+         * Constructor. Allocates every buffer, so it must not be called on the audio thread.
+         *
+         * \param capacity Channel count, maximum sample rate, block size and lowest refresh rate to size for.
+         */
+        Buffers(const Geometry &capacity)
+            : maxGeometry(capacity),
+              queue((int)capacity.sampleRate, capacity.framesPerSecond, capacity.blockSize, capacity.numChannels),
+              pyramids(makePyramids(capacity.numChannels)),
+              frames((size_t)(capacity.sampleRate * maxFrameSeconds), capacity.numChannels),
+              collector(queue, pyramids, frames)
+        {
+        }
+
+        /**
+         * Returns whether a geometry fits in these buffers.
+         *
+         * \param geometry Geometry to check.
+         * \return true if no allocation is needed for it.
+         * \return false otherwise.
+         */
+        bool canHold(const Geometry &geometry) const
+        {
+            return geometry.numChannels == maxGeometry.numChannels && geometry.sampleRate <= maxGeometry.sampleRate && geometry.blockSize <= maxGeometry.blockSize && geometry.framesPerSecond >= maxGeometry.framesPerSecond;
+        }
+
+        /**
+         * Get the SummaryPyramid object of a channel.
+         *
+         * \param channel Channel index.
+         * \return SummaryPyramid<SampleType>* Summaries of the channel.
+         */
+        SummaryPyramid<SampleType> *getPyramid(int channel)
+        {
+            return pyramids[(size_t)channel].get();
+        }
+
+        const Geometry maxGeometry;                                            /**< Capacity */
+        AudioBufferQueue<SampleType> queue;                                    /**< Samples streamed to the GUI */
+        std::vector<std::unique_ptr<SummaryPyramid<SampleType>>> pyramids;     /**< One SummaryPyramid per channel */
+        TriggeredFrameBuffer<SampleType> frames;                               /**< Trigger-aligned acquisitions */
+        ScopeDataCollector<SampleType> collector;                              /**< Fills all of the above */
+
+    private:
+        /**
+         * Allocates one SummaryPyramid per channel.
+         *
+         * \param numChannels Number of channels.
+         * \return Pyramids.
+         */
+        static std::vector<std::unique_ptr<SummaryPyramid<SampleType>>> makePyramids(int numChannels)
+        {
+            std::vector<std::unique_ptr<SummaryPyramid<SampleType>>> result;
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                result.push_back(std::make_unique<SummaryPyramid<SampleType>>());
+            }
+            return result;
+        }
+    };
+
+    /**
+     * A published configuration. Immutable once published.
+     */
+    struct State
+    {
+        std::shared_ptr<Buffers> buffers; /**< Buffers to use */
+        Geometry geometry;                /**< Geometry to use them with */
+        juce::uint32 epoch = 0;           /**< Publication counter */
+    };
+
+    //==============================================================================
+    /**
+     * Constructor. Allocates buffers for the given geometry.
+     *
+     * \param initialGeometry Geometry to start with.
+     * \param minimumCapacity Sample rate and block size to size buffers for at least.
+     */
+    CaptureResources(const Geometry &initialGeometry, const Geometry &minimumCapacity)
+        : preallocated(minimumCapacity)
+    {
+        current.store(new State{std::make_shared<Buffers>(getCapacity(initialGeometry)), initialGeometry, 0});
+        for (auto &slot : readerEpochs)
+        {
+            slot.store(freeSlot);
+        }
+    }
+
+    /**
+     * Destructor. No reader may be attached anymore.
+     *
+     */
+    ~CaptureResources()
+    {
+        jassert(numUnpinnedReaders.load() == 0);
+        jassert(std::all_of(readerEpochs.begin(), readerEpochs.end(), [](auto &slot)
+                            { return slot.load() == freeSlot; }));
+        delete current.load();
+        for (auto state : retired)
+        {
+            delete state;
+        }
+    }
+
+    //==============================================================================
+    /**
+     * Publishes a new geometry. To be called from prepareToPlay, i.e. never
+     * concurrently with @ref getAudioState.
+     *
+     * Buffers are reused whenever they can hold the geometry and allocated
+     * otherwise. Replaced States are kept until no reader can see them.
+     *
+     * \param geometry New geometry.
+     */
+    void prepare(const Geometry &geometry)
+    {
+        auto previous = current.load();
+        auto buffers = previous->buffers->canHold(geometry) ? previous->buffers : std::make_shared<Buffers>(getCapacity(geometry));
+
+        // swap in, then retire the previous state
+        current.store(new State{buffers, geometry, previous->epoch + 1});
+        epoch.store(previous->epoch + 1);
+        retired.push_back(previous);
+        reclaim();
+    }
+
+    /**
+     * Get the current State. To be called from the audio thread at the start of
+     * each block; the first call after @ref prepare clears the buffers.
+     *
+     * \return State& Current State.
+     */
+    State &getAudioState()
+    {
+        auto state = current.load(std::memory_order_acquire);
+        if (state->epoch != audioEpoch)
+        {
+            state->buffers->collector.reset();
+            audioEpoch = state->epoch;
+        }
+        return *state;
+    }
+
+    //==============================================================================
+    /**
+     * Registers a GUI reader. To be paired with @ref detachReader. Readers may
+     * overlap, e.g. while the editor replaces its view.
+     *
+     * \return int Reader id to acquire with, or -1 if every slot is taken, in
+     * which case nothing is freed until the reader detaches.
+     */
+    int attachReader()
+    {
+        // pin the current epoch at once, acquire moves it forward
+        for (int reader = 0; reader < maxReaders; ++reader)
+        {
+            auto expected = freeSlot;
+            if (readerEpochs[(size_t)reader].compare_exchange_strong(expected, epoch.load()))
+            {
+                return reader;
+            }
+        }
+
+        jassertfalse;
+        numUnpinnedReaders.fetch_add(1);
+        return -1;
+    }
+
+    /**
+     * Unregisters a GUI reader.
+     *
+     * \param reader Id returned by @ref attachReader.
+     */
+    void detachReader(int reader)
+    {
+        if (reader < 0)
+        {
+            numUnpinnedReaders.fetch_sub(1);
+            return;
+        }
+        readerEpochs[(size_t)reader].store(freeSlot);
+    }
+
+    /**
+     * Get the current State. To be called from the message thread by an
+     * attached reader. The returned State, and everything it points to, stays
+     * valid until the next call by the same reader.
+     *
+     * \param reader Id returned by @ref attachReader.
+     * \return const State& Current State.
+     */
+    const State &acquire(int reader)
+    {
+        while (true)
+        {
+            // announce the epoch first, so that prepare keeps what may be read
+            auto pinned = epoch.load();
+            if (reader >= 0)
+            {
+                readerEpochs[(size_t)reader].store(pinned);
+            }
+            auto state = current.load();
+            if (state->epoch == pinned)
+            {
+                return *state;
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    static constexpr double maxFrameSeconds = 1.; /**< Longest triggered frame, in seconds */
+    static constexpr int maxReaders = 8;          /**< Readers with an epoch slot */
+    static constexpr juce::uint32 freeSlot = std::numeric_limits<juce::uint32>::max(); /**< Epoch of an unused slot */
+
+    /**
+     * Get the geometry to size buffers for.
+     *
+     * \param geometry Requested geometry.
+     * \return Geometry Requested geometry raised to the preallocated capacity.
+     */
+    Geometry getCapacity(const Geometry &geometry) const
+    {
+        auto capacity = geometry;
+        capacity.sampleRate = std::max(geometry.sampleRate, preallocated.sampleRate);
+        capacity.blockSize = std::max(geometry.blockSize, preallocated.blockSize);
+        capacity.framesPerSecond = std::min(geometry.framesPerSecond, preallocated.framesPerSecond);
+        return capacity;
+    }
+
+    /**
+     * Frees the retired States no reader can see anymore.
+     *
+     */
+    void reclaim()
+    {
+        // oldest epoch any reader may still use, free slots being above all
+        if (numUnpinnedReaders.load() > 0)
+        {
+            return;
+        }
+        auto oldest = freeSlot;
+        for (auto &slot : readerEpochs)
+        {
+            oldest = std::min(oldest, slot.load());
+        }
+        auto isUnreachable = [oldest](State *state)
+        {
+            return oldest > state->epoch;
+        };
+
+        for (auto it = retired.begin(); it != retired.end();)
+        {
+            if (isUnreachable(*it))
+            {
+                delete *it;
+                it = retired.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    const Geometry preallocated;                  /**< Minimum capacity of every allocation */
+    std::atomic<State *> current{nullptr};        /**< Published State */
+    std::atomic<juce::uint32> epoch{0};           /**< Epoch of the published State */
+    std::array<std::atomic<juce::uint32>, maxReaders> readerEpochs; /**< Last epoch acquired by each reader, freeSlot if unused */
+    std::atomic<int> numUnpinnedReaders{0};                         /**< Attached readers without a slot */
+    juce::uint32 audioEpoch = 0;                  /**< Last epoch seen by the audio thread */
+    std::vector<State *> retired;                 /**< Replaced States, kept while readable */
+};
@@ -0,0 +1,301 @@
+/*
+  ==============================================================================
+
+    CrossingSearch.h
+    Created: 18 Oct 2026 6:17:40pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define OSCILLOSCOPE_CROSSING_SEARCH_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OSCILLOSCOPE_CROSSING_SEARCH_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define OSCILLOSCOPE_CROSSING_SEARCH_NEON 1
+#endif
+
+/**
+ * Level-crossing search kernels.
+ *
+ * A crossing of a crescent slope is a sample at or above the threshold whose
+ * predecessor is below it, a crossing of a decrescent slope a sample at or
+ * below the threshold whose predecessor is above it.
+ *
+ * The float kernels compare 16 (AVX) or 8 (SSE2, NEON) samples per step, with a
+ * scalar fallback on other targets and sample types. findWithMaximum fuses the
+ * peak scan of automatic triggering with the crossing search, so a block is
+ * read only once.
+ */
+template <typename SampleType>
+struct CrossingSearch
+{
+    /**
+     * Result of findWithMaximum.
+     */
+    struct Result
+    {
+        int index;          /**< Index of the first sample after the crossing, -1 if not found */
+        SampleType maximum; /**< Largest sample of the whole block */
+    };
+
+    //==============================================================================
+    /**
+     * Finds the first crossing in data[startIndex, numSamples).
+     *
+     * \param data Block samples.
+     * \param numSamples Number of samples.
+     * \param startIndex First sample to examine.
+     * \param threshold Level to cross.
+     * \param previous Sample preceding data[startIndex].
+     * \return int Index of the first sample after the crossing, -1 if not found.
+     */
+    template <bool isFalling>
+    static int find(const SampleType *data, int numSamples, int startIndex, SampleType threshold, SampleType previous)
+    {
+        SampleType unusedMaximum = std::numeric_limits<SampleType>::lowest();
+        return search<isFalling, false>(data, numSamples, startIndex, threshold, previous, unusedMaximum);
+    }
+
+    /**
+     * Finds the first crossing in data[0, numSamples) and the largest sample of
+     * the whole block in the same pass.
+     *
+     * \param data Block samples.
+     * \param numSamples Number of samples.
+     * \param threshold Level to cross.
+     * \param previous Sample preceding data[0].
+     * \return Result First crossing & maximum.
+     */
+    template <bool isFalling>
+    static Result findWithMaximum(const SampleType *data, int numSamples, SampleType threshold, SampleType previous)
+    {
+        SampleType maximum = std::numeric_limits<SampleType>::lowest();
+        auto index = search<isFalling, true>(data, numSamples, 0, threshold, previous, maximum);
+
+        // samples after the crossing still count for the peak
+        if (index >= 0)
+        {
+            for (int i = index; i < numSamples; ++i)
+            {
+                maximum = std::max(maximum, data[i]);
+            }
+        }
+        return {index, maximum};
+    }
+
+private:
+    //==============================================================================
+    /**
+     * Checks two consecutive samples for a crossing.
+     *
+     * \param previous Earlier sample.
+     * \param current Later sample.
+     * \param threshold Level to cross.
+     * \return true if the level is crossed between them.
+     */
+    template <bool isFalling>
+    static bool isCrossing(SampleType previous, SampleType current, SampleType threshold)
+    {
+        return isFalling ? (previous > threshold && current <= threshold)
+                         : (previous < threshold && current >= threshold);
+    }
+
+    /**
+     * Scalar search, optionally tracking the largest examined sample.
+     *
+     * \return int Index of the first sample after the crossing, -1 if not found.
+     */
+    template <bool isFalling, bool trackMaximum>
+    static int search(const SampleType *data, int numSamples, int startIndex, SampleType threshold, SampleType previous, SampleType &maximum)
+    {
+        for (int i = startIndex; i < numSamples; ++i)
+        {
+            auto current = data[i];
+            if (trackMaximum)
+            {
+                maximum = std::max(maximum, current);
+            }
+            if (isCrossing<isFalling>(previous, current, threshold))
+            {
+                return i;
+            }
+            previous = current;
+        }
+        return -1;
+    }
+};
+
+#if OSCILLOSCOPE_CROSSING_SEARCH_AVX || OSCILLOSCOPE_CROSSING_SEARCH_SSE2 || OSCILLOSCOPE_CROSSING_SEARCH_NEON
+/**
+ * Vectorised search for float samples.
+ *
+ * The first sample is compared with the given predecessor, every following one
+ * with its predecessor in data, so that unaligned loads at i and i - 1 give
+ * both operands of a whole step at once.
+ */
+template <>
+template <bool isFalling, bool trackMaximum>
+inline int CrossingSearch<float>::search(const float *data, int numSamples, int startIndex, float threshold, float previous, float &maximum)
+{
+    int i = startIndex;
+    if (i >= numSamples)
+    {
+        return -1;
+    }
+
+    // first sample against the given predecessor
+    if (trackMaximum)
+    {
+        maximum = std::max(maximum, data[i]);
+    }
+    if (isCrossing<isFalling>(previous, data[i], threshold))
+    {
+        return i;
+    }
+    ++i;
+
+#if OSCILLOSCOPE_CROSSING_SEARCH_AVX
+    // 16 samples per step
+    constexpr int step = 16;
+    auto thresholds = _mm256_set1_ps(threshold);
+    auto maxima = _mm256_set1_ps(maximum);
+    for (; i + step <= numSamples; i += step)
+    {
+        auto current0 = _mm256_loadu_ps(data + i);
+        auto current1 = _mm256_loadu_ps(data + i + 8);
+        auto previous0 = _mm256_loadu_ps(data + i - 1);
+        auto previous1 = _mm256_loadu_ps(data + i + 7);
+        if (trackMaximum)
+        {
+            maxima = _mm256_max_ps(maxima, _mm256_max_ps(current0, current1));
+        }
+
+        __m256 mask0, mask1;
+        if (isFalling)
+        {
+            mask0 = _mm256_and_ps(_mm256_cmp_ps(previous0, thresholds, _CMP_GT_OQ), _mm256_cmp_ps(current0, thresholds, _CMP_LE_OQ));
+            mask1 = _mm256_and_ps(_mm256_cmp_ps(previous1, thresholds, _CMP_GT_OQ), _mm256_cmp_ps(current1, thresholds, _CMP_LE_OQ));
+        }
+        else
+        {
+            mask0 = _mm256_and_ps(_mm256_cmp_ps(previous0, thresholds, _CMP_LT_OQ), _mm256_cmp_ps(current0, thresholds, _CMP_GE_OQ));
+            mask1 = _mm256_and_ps(_mm256_cmp_ps(previous1, thresholds, _CMP_LT_OQ), _mm256_cmp_ps(current1, thresholds, _CMP_GE_OQ));
+        }
+
+        auto bits = _mm256_movemask_ps(mask0) | (_mm256_movemask_ps(mask1) << 8);
+        if (bits != 0)
+        {
+            break;
+        }
+    }
+    if (trackMaximum)
+    {
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, maxima);
+        maximum = *std::max_element(lanes, lanes + 8);
+    }
+#elif OSCILLOSCOPE_CROSSING_SEARCH_SSE2
+    // 8 samples per step
+    constexpr int step = 8;
+    auto thresholds = _mm_set1_ps(threshold);
+    auto maxima = _mm_set1_ps(maximum);
+    for (; i + step <= numSamples; i += step)
+    {
+        auto current0 = _mm_loadu_ps(data + i);
+        auto current1 = _mm_loadu_ps(data + i + 4);
+        auto previous0 = _mm_loadu_ps(data + i - 1);
+        auto previous1 = _mm_loadu_ps(data + i + 3);
+        if (trackMaximum)
+        {
+            maxima = _mm_max_ps(maxima, _mm_max_ps(current0, current1));
+        }
+
+        __m128 mask0, mask1;
+        if (isFalling)
+        {
+            mask0 = _mm_and_ps(_mm_cmpgt_ps(previous0, thresholds), _mm_cmple_ps(current0, thresholds));
+            mask1 = _mm_and_ps(_mm_cmpgt_ps(previous1, thresholds), _mm_cmple_ps(current1, thresholds));
+        }
+        else
+        {
+            mask0 = _mm_and_ps(_mm_cmplt_ps(previous0, thresholds), _mm_cmpge_ps(current0, thresholds));
+            mask1 = _mm_and_ps(_mm_cmplt_ps(previous1, thresholds), _mm_cmpge_ps(current1, thresholds));
+        }
+
+        auto bits = _mm_movemask_ps(mask0) | (_mm_movemask_ps(mask1) << 4);
+        if (bits != 0)
+        {
+            break;
+        }
+    }
+    if (trackMaximum)
+    {
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, maxima);
+        maximum = *std::max_element(lanes, lanes + 4);
+    }
+#elif OSCILLOSCOPE_CROSSING_SEARCH_NEON
+    // 8 samples per step
+    constexpr int step = 8;
+    auto thresholds = vdupq_n_f32(threshold);
+    auto maxima = vdupq_n_f32(maximum);
+    for (; i + step <= numSamples; i += step)
+    {
+        auto current0 = vld1q_f32(data + i);
+        auto current1 = vld1q_f32(data + i + 4);
+        auto previous0 = vld1q_f32(data + i - 1);
+        auto previous1 = vld1q_f32(data + i + 3);
+        if (trackMaximum)
+        {
+            maxima = vmaxq_f32(maxima, vmaxq_f32(current0, current1));
+        }
+
+        uint32x4_t mask0, mask1;
+        if (isFalling)
+        {
+            mask0 = vandq_u32(vcgtq_f32(previous0, thresholds), vcleq_f32(current0, thresholds));
+            mask1 = vandq_u32(vcgtq_f32(previous1, thresholds), vcleq_f32(current1, thresholds));
+        }
+        else
+        {
+            mask0 = vandq_u32(vcltq_f32(previous0, thresholds), vcgeq_f32(current0, thresholds));
+            mask1 = vandq_u32(vcltq_f32(previous1, thresholds), vcgeq_f32(current1, thresholds));
+        }
+
+        if (vmaxvq_u32(vorrq_u32(mask0, mask1)) != 0)
+        {
+            break;
+        }
+    }
+    if (trackMaximum)
+    {
+        maximum = vmaxvq_f32(maxima);
+    }
+#endif
+
+    // the step holding the crossing and the remaining tail are searched one sample at a time
+    for (; i < numSamples; ++i)
+    {
+        if (trackMaximum)
+        {
+            maximum = std::max(maximum, data[i]);
+        }
+        if (isCrossing<isFalling>(data[i - 1], data[i], threshold))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+#endif
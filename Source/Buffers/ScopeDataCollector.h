@@ -10,113 +10,145 @@
 
 #pragma once
 #include "AudioBufferQueue.h"
+#include "SummaryPyramid.h"
+#include "CaptureEngine.h"
+#include "ActivityDetector.h"
 #include <cstdlib>
+#include <memory>
+#include <vector>
 
 /**
  * Class handling AudioBufferQueue.
  *
- * Automatically fills a buffer, pushes it to the queue and starts filling the next one.
+ * Streams every incoming multi-channel block straight into the queue and
+ * summarises each channel into its own SummaryPyramid for long windows. When
+ * triggering is enabled the block also goes through a CaptureEngine that
+ * publishes trigger-aligned acquisitions of all channels.
+ *
+ * Once an ActivityDetector finds the input quiet, blocks are no longer pushed
+ * into the queue, so that the editor has nothing to redraw.
  */
 template <typename SampleType>
 class ScopeDataCollector
 {
 public:
     //==============================================================================
-    ScopeDataCollector(AudioBufferQueue<SampleType> &queueToUse)
-        : audioBufferQueue(queueToUse)
+    ScopeDataCollector(AudioBufferQueue<SampleType> &queueToUse,
+                       std::vector<std::unique_ptr<SummaryPyramid<SampleType>>> &pyramidsToUse,
+                       TriggeredFrameBuffer<SampleType> &framesToUse)
+        : audioBufferQueue(queueToUse), summaryPyramids(pyramidsToUse), captureEngine(framesToUse)
+    {
+    }
+
+    /**
+     * Sets trigger settings. To be called from the audio thread before process().
+     *
+     * \param shouldTrigger Whether to acquire triggered frames.
+     * \param level Trigger level.
+     * \param isFalling Whether to trigger on decrescent slope.
+     * \param isAutomatic Whether the level is relative to the signal peak.
+     * \param frameLength Samples per acquisition.
+     * \param preTriggerRatio Fraction of each acquisition taken before the crossing.
+     * \param holdoffLength Minimum samples between two crossings.
+     */
+    void setTriggerSettings(bool shouldTrigger, SampleType level, bool isFalling, bool isAutomatic,
+                            size_t frameLength, float preTriggerRatio, size_t holdoffLength)
+    {
+        // start from scratch when switching trigger on
+        if (shouldTrigger && !isTriggerEnabled)
+        {
+            captureEngine.rearm();
+        }
+
+        isTriggerEnabled = shouldTrigger;
+        captureEngine.setSettings(level, isFalling, isAutomatic, frameLength, preTriggerRatio, holdoffLength);
+    }
+
+    /**
+     * Sets how long the input must stay silent before blocks stop being
+     * queued. To be called from the audio thread before process().
+     *
+     * \param holdLength Hold time in samples.
+     */
+    void setSilenceHold(size_t holdLength)
     {
-        // resize buffer
-        buffer.resize(queueToUse.getBufferSize());
-        bufferSize = buffer.size();
+        activityDetector.setHoldLength(holdLength);
+    }
 
-        // reset num collected
-        numCollected = 0;
+    /**
+     * Clears the summaries, the trigger history and the silence state. To be
+     * called from the audio thread, before process().
+     *
+     */
+    void reset()
+    {
+        for (auto &pyramid : summaryPyramids)
+        {
+            pyramid->reset();
+        }
+        captureEngine.reset();
+        activityDetector.reset();
     }
 
     //==============================================================================
     /**
      * Processes incoming data.
      *
-     * \param data pointer to a series of data.
+     * \param data pointers to a series of data, one per channel.
+     * \param numChannels number of channels in data.
      * \param numSamples number of samples in the series.
+     * \return size_t Number of samples the queue had no room for.
      */
-    void process(const SampleType *data, size_t numSamples)
+    size_t process(const SampleType *const *data, int numChannels, size_t numSamples)
     {
-        // declare variables
-        size_t index = 0;
-        int numBuffersToPush = numSamples / bufferSize;
-        int numSamplesExceeding = numSamples % bufferSize;
-        int numEmptyBuffers = 0;
-        int additionalSamples = 0;
-
-        // if no samples still collected
-        if (state == State::waitingForTrigger)
+        // summarise every channel
+        numChannels = std::min(numChannels, (int)summaryPyramids.size());
+        for (int channel = 0; channel < numChannels; ++channel)
         {
-            std::fill(buffer.begin(), buffer.end(), 0);
-            // If no sample over treshold push silence.
-            if (std::all_of(data, data + numSamples, [](SampleType i)
-                            { return i < triggerLevel; }))
-            {
-                for (size_t i = 0; i < numBuffersToPush; i++)
-                {
-                    audioBufferQueue.push(buffer.data(), bufferSize);
-                }
-                numCollected = numSamplesExceeding;
-            }
-            // Else setup collecting stage
-            else
-            {
-                auto result = data;
-                while (*result < triggerLevel)
-                {
-                    result++;
-                }
-                prevSample = *result;
-                state = State::collecting;
-                int firstSample = result - data;
-                numEmptyBuffers = firstSample / bufferSize;
-                additionalSamples = firstSample % bufferSize;
-                for (size_t i = 0; i < numEmptyBuffers; i++)
-                {
-                    audioBufferQueue.push(buffer.data(), bufferSize);
-                }
-                numCollected = additionalSamples;
-                index = firstSample;
-            }
+            summaryPyramids[channel]->process(data[channel], numSamples);
         }
 
-        // if already collecting
-        if (state == State::collecting)
+        // acquire triggered frames
+        if (isTriggerEnabled)
         {
-            while (index++ < numSamples)
-            {
-                buffer[numCollected++] = *data++;
+            captureEngine.process(data, numChannels, numSamples);
+        }
 
-                if (numCollected == buffer.size())
-                {
-                    audioBufferQueue.push(buffer.data(), buffer.size());
-                    numCollected = 0;
-                }
-            }
+        // nothing changes on screen while quiet
+        if (activityDetector.process(data, numChannels, numSamples))
+        {
+            return 0;
         }
-    }
 
-private:
-    //==============================================================================
-    AudioBufferQueue<SampleType> &audioBufferQueue; /**< AudioBufferQueue */
-    std::vector<SampleType> buffer;                 /**< Buffer to fill and push to audioBufferQueue */
-    int bufferSize;                                 /**< Size of @param buffer */
-    size_t numCollected;                            /**< Number of samples collected. */
-    SampleType prevSample = SampleType(100);        /**< Last sample collected. */
+        // push the whole block, all channels at the same index
+        return numSamples - audioBufferQueue.push(data, numChannels, numSamples);
+    }
 
-    static constexpr auto triggerLevel = SampleType(0); /**< Level above which the oscilloscope starts drawing the waveform. */
+    /**
+     * Get the silence state of the input. Safe from any thread.
+     *
+     * \return const ActivityDetector<SampleType>& Silence state.
+     */
+    const ActivityDetector<SampleType> &getActivity() const
+    {
+        return activityDetector;
+    }
 
     /**
-     * States of the class.
+     * Get the number of triggered acquisitions published so far.
+     *
+     * \return juce::uint64 Number of triggers.
      */
-    enum class State
+    juce::uint64 getNumTriggers() const
     {
-        waitingForTrigger,
-        collecting
-    } state{State::waitingForTrigger};
-};
\ No newline at end of file
+        return captureEngine.getNumTriggers();
+    }
+
+private:
+    //==============================================================================
+    AudioBufferQueue<SampleType> &audioBufferQueue;                            /**< AudioBufferQueue */
+    std::vector<std::unique_ptr<SummaryPyramid<SampleType>>> &summaryPyramids; /**< One SummaryPyramid per channel */
+    CaptureEngine<SampleType> captureEngine;                                   /**< Acquires trigger-aligned frames */
+    ActivityDetector<SampleType> activityDetector;                             /**< Tells when the input went quiet */
+    bool isTriggerEnabled = false;                                             /**< Whether to acquire triggered frames */
+};
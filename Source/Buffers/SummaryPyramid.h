@@ -0,0 +1,282 @@
+/*
+  ==============================================================================
+
+    SummaryPyramid.h
+    Created: 18 Oct 2026 11:02:47am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+/**
+ * Multi-resolution pyramid of min/max/RMS summaries of a sample stream.
+ *
+ * Level 0 summarises baseBucketSize samples per entry and every following level
+ * summarises decimationFactor entries of the previous one. Each level is a ring
+ * of entriesPerLevel entries, so coarse levels reach back several minutes.
+ *
+ * The audio thread appends samples in amortised O(1) per sample, the GUI reads
+ * any window of the recent history in O(columns).
+ */
+template <typename SampleType>
+class SummaryPyramid
+{
+public:
+    //==============================================================================
+    static constexpr int numLevels = 8;                   /**< Number of levels */
+    static constexpr size_t baseBucketSize = 16;          /**< Samples summarised by a level 0 entry */
+    static constexpr size_t decimationFactor = 4;         /**< Entries of a level merged into one entry of the next */
+    static constexpr size_t entriesPerLevel = 1 << 14;    /**< Ring size of each level (power of two) */
+
+    /**
+     * Summary of a span of samples.
+     */
+    struct Summary
+    {
+        SampleType min;          /**< Minimum sample */
+        SampleType max;          /**< Maximum sample */
+        SampleType sumOfSquares; /**< Sum of squared samples */
+    };
+
+    //==============================================================================
+    /**
+     * Constructor. Allocates every level up front.
+     *
+     */
+    SummaryPyramid()
+    {
+        for (auto &level : levels)
+        {
+            level.entries.calloc(entriesPerLevel);
+        }
+        reset();
+    }
+
+    /**
+     * Clears the history. Must not be called while process() is running.
+     *
+     */
+    void reset()
+    {
+        pending = emptySummary();
+        numPending = 0;
+        for (auto &level : levels)
+        {
+            level.accumulator = emptySummary();
+            level.numAccumulated = 0;
+            level.numWritten.store(0, std::memory_order_release);
+        }
+    }
+
+    //==============================================================================
+    /**
+     * Appends samples to the pyramid. To be called from the audio thread only.
+     *
+     * \param data Samples.
+     * \param numSamples Number of samples.
+     */
+    void process(const SampleType *data, size_t numSamples)
+    {
+        while (numSamples > 0)
+        {
+            // accumulate up to the end of the current level 0 bucket
+            auto chunk = std::min(numSamples, baseBucketSize - numPending);
+            for (size_t i = 0; i < chunk; ++i)
+            {
+                pending.min = std::min(pending.min, data[i]);
+                pending.max = std::max(pending.max, data[i]);
+                pending.sumOfSquares += data[i] * data[i];
+            }
+            numPending += chunk;
+            data += chunk;
+            numSamples -= chunk;
+
+            // bucket complete, push it up the pyramid
+            if (numPending == baseBucketSize)
+            {
+                append(0, pending);
+                pending = emptySummary();
+                numPending = 0;
+            }
+        }
+    }
+
+    //==============================================================================
+    /**
+     * Get the number of samples summarised so far.
+     *
+     * \return size_t Number of samples covered by level 0.
+     */
+    size_t getNumSamplesSummarised() const
+    {
+        return levels[0].numWritten.load(std::memory_order_acquire) * baseBucketSize;
+    }
+
+    /**
+     * Get the longest window, in samples, that the pyramid can still render.
+     *
+     * \return size_t Maximum window length in samples.
+     */
+    static constexpr size_t getMaxWindowLength()
+    {
+        return samplesPerEntry(numLevels - 1) * (entriesPerLevel - safetyMargin);
+    }
+
+    /**
+     * Renders the most recent windowLength samples into numColumns summaries.
+     * To be called from the GUI thread only.
+     *
+     * Columns reaching back before the available history are set to 0.
+     *
+     * \param windowLength Window length in samples.
+     * \param numColumns Number of columns to render.
+     * \param minOutput Where to write the minimum of each column.
+     * \param maxOutput Where to write the maximum of each column.
+     * \param rmsOutput Where to write the RMS of each column, can be nullptr.
+     */
+    void render(size_t windowLength, int numColumns, SampleType *minOutput, SampleType *maxOutput, SampleType *rmsOutput = nullptr) const
+    {
+        // choose the coarsest level giving at least one entry per column
+        auto samplesPerColumn = (double)windowLength / (double)std::max(numColumns, 1);
+        int levelIndex = 0;
+        while (levelIndex < numLevels - 1 && (double)samplesPerEntry(levelIndex + 1) <= samplesPerColumn)
+        {
+            levelIndex++;
+        }
+
+        // make sure the level reaches back far enough
+        while (levelIndex < numLevels - 1 && windowLength > samplesPerEntry(levelIndex) * (entriesPerLevel - safetyMargin))
+        {
+            levelIndex++;
+        }
+
+        // get readable entries of the chosen level
+        auto &level = levels[levelIndex];
+        auto entrySize = samplesPerEntry(levelIndex);
+        auto numWritten = level.numWritten.load(std::memory_order_acquire);
+        auto firstReadable = numWritten > entriesPerLevel - safetyMargin ? numWritten - (entriesPerLevel - safetyMargin) : 0;
+
+        // window expressed in entries of this level, ending at the last complete entry
+        auto windowEntries = (double)windowLength / (double)entrySize;
+        auto windowStart = (double)numWritten - windowEntries;
+
+        for (int column = 0; column < numColumns; ++column)
+        {
+            // entries covered by this column
+            auto start = windowStart + windowEntries * column / numColumns;
+            auto end = windowStart + windowEntries * (column + 1) / numColumns;
+            auto first = (long long)std::floor(start);
+            auto last = std::max((long long)std::ceil(end), first + 1);
+
+            // merge them
+            auto summary = emptySummary();
+            size_t numMerged = 0;
+            for (auto i = std::max(first, (long long)firstReadable); i < last && i < (long long)numWritten; ++i)
+            {
+                auto &entry = level.entries[(size_t)i & (entriesPerLevel - 1)];
+                summary.min = std::min(summary.min, entry.min);
+                summary.max = std::max(summary.max, entry.max);
+                summary.sumOfSquares += entry.sumOfSquares;
+                numMerged++;
+            }
+
+            // write column
+            if (numMerged == 0)
+            {
+                summary = {SampleType(0), SampleType(0), SampleType(0)};
+            }
+            minOutput[column] = summary.min;
+            maxOutput[column] = summary.max;
+            if (rmsOutput != nullptr)
+            {
+                rmsOutput[column] = numMerged > 0 ? std::sqrt(summary.sumOfSquares / SampleType(numMerged * entrySize)) : SampleType(0);
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    static constexpr size_t safetyMargin = entriesPerLevel / 4; /**< Oldest entries not read, as the writer may be overwriting them */
+
+    /**
+     * A level of the pyramid.
+     */
+    struct Level
+    {
+        juce::HeapBlock<Summary> entries;       /**< Ring of summaries */
+        std::atomic<size_t> numWritten{0};      /**< Total entries written, published to the reader */
+        Summary accumulator;                    /**< Entries merged so far for the next level */
+        size_t numAccumulated = 0;              /**< Number of entries in accumulator */
+    };
+
+    /**
+     * Samples summarised by one entry of a level.
+     *
+     * \param levelIndex Level index.
+     * \return size_t Samples per entry.
+     */
+    static constexpr size_t samplesPerEntry(int levelIndex)
+    {
+        size_t size = baseBucketSize;
+        for (int i = 0; i < levelIndex; ++i)
+        {
+            size *= decimationFactor;
+        }
+        return size;
+    }
+
+    /**
+     * Summary that any sample will replace.
+     *
+     * \return Summary Empty summary.
+     */
+    static Summary emptySummary()
+    {
+        return {std::numeric_limits<SampleType>::max(), std::numeric_limits<SampleType>::lowest(), SampleType(0)};
+    }
+
+    /**
+     * Writes an entry to a level and merges it into the next one.
+     *
+     * \param levelIndex Level index.
+     * \param summary Entry to write.
+     */
+    void append(int levelIndex, const Summary &summary)
+    {
+        auto &level = levels[levelIndex];
+
+        // write & publish
+        auto numWritten = level.numWritten.load(std::memory_order_relaxed);
+        level.entries[numWritten & (entriesPerLevel - 1)] = summary;
+        level.numWritten.store(numWritten + 1, std::memory_order_release);
+
+        // last level has no parent
+        if (levelIndex == numLevels - 1)
+        {
+            return;
+        }
+
+        // merge into next level
+        level.accumulator.min = std::min(level.accumulator.min, summary.min);
+        level.accumulator.max = std::max(level.accumulator.max, summary.max);
+        level.accumulator.sumOfSquares += summary.sumOfSquares;
+        if (++level.numAccumulated == decimationFactor)
+        {
+            append(levelIndex + 1, level.accumulator);
+            level.accumulator = emptySummary();
+            level.numAccumulated = 0;
+        }
+    }
+
+    std::array<Level, numLevels> levels; /**< Levels, finest first */
+    Summary pending;                     /**< Level 0 bucket being filled */
+    size_t numPending = 0;               /**< Samples in pending */
+};
@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+    TriggerDetector.h
+    Created: 18 Oct 2026 12:21:09pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CrossingSearch.h"
+
+/**
+ * Real-time safe level-crossing detector.
+ *
+ * Finds where the signal crosses the trigger level with the configured slope,
+ * at sample resolution plus a linearly interpolated sub-sample offset. Blocks
+ * are searched as one continuous stream, so crossings between the last sample
+ * of a block and the first sample of the next one are detected too.
+ *
+ * Searches run on the vectorised @ref CrossingSearch kernels. Slope and
+ * automatic mode are template parameters of the search, resolved once per
+ * block through @ref visitMode, so no flag is tested per sample. In automatic
+ * mode the threshold follows the peak of the previous blocks, so that the peak
+ * of the current block is measured in the same pass that searches it.
+ */
+template <typename SampleType>
+class TriggerDetector
+{
+public:
+    //==============================================================================
+    /**
+     * Sets the trigger level. In automatic mode it is relative to the signal peak.
+     *
+     * \param newLevel Trigger level.
+     */
+    void setLevel(SampleType newLevel)
+    {
+        level = newLevel;
+    }
+
+    /**
+     * Sets the slope to trigger on.
+     *
+     * \param shouldTriggerOnFalling true for decrescent slope, false for crescent slope.
+     */
+    void setFalling(bool shouldTriggerOnFalling)
+    {
+        isFalling = shouldTriggerOnFalling;
+    }
+
+    /**
+     * Sets whether the level is relative to the signal peak.
+     *
+     * \param shouldBeAutomatic true for automatic mode.
+     */
+    void setAutomatic(bool shouldBeAutomatic)
+    {
+        isAutomatic = shouldBeAutomatic;
+    }
+
+    /**
+     * Forgets the stream history.
+     *
+     */
+    void reset()
+    {
+        previousSample = SampleType(0);
+        peak = SampleType(0);
+    }
+
+    //==============================================================================
+    /**
+     * Calls visitor with the current slope and automatic mode as compile-time
+     * constants, i.e. std::bool_constant arguments (isFalling, isAutomatic).
+     *
+     * \param visitor Generic callable.
+     * \return Whatever visitor returns.
+     */
+    template <typename Visitor>
+    decltype(auto) visitMode(Visitor &&visitor) const
+    {
+        if (isFalling)
+        {
+            return isAutomatic ? visitor(std::true_type{}, std::true_type{}) : visitor(std::true_type{}, std::false_type{});
+        }
+        return isAutomatic ? visitor(std::false_type{}, std::true_type{}) : visitor(std::false_type{}, std::false_type{});
+    }
+
+    /**
+     * Sets the threshold of a block and, in automatic mode, searches it from its
+     * first sample while updating the peak. Call once per block, before
+     * searching it.
+     *
+     * \tparam falling Slope, as passed by @ref visitMode.
+     * \tparam automatic Automatic mode, as passed by @ref visitMode.
+     * \param data Block samples.
+     * \param numSamples Number of samples.
+     */
+    template <bool falling, bool automatic>
+    void analyseBlock(const SampleType *data, int numSamples)
+    {
+        threshold = automatic ? level * peak : level;
+        hasFirstCrossing = false;
+        if (!automatic || numSamples <= 0)
+        {
+            return;
+        }
+
+        // one pass finds the first crossing and the block peak
+        auto result = CrossingSearch<SampleType>::template findWithMaximum<falling>(data, numSamples, threshold, previousSample);
+        firstCrossing = result.index;
+        hasFirstCrossing = true;
+
+        // peak follows the signal up immediately and releases slowly
+        peak = std::max(result.maximum, peak * peakRelease);
+    }
+
+    /**
+     * Finds the first crossing in data[startIndex, numSamples).
+     *
+     * \tparam falling Slope, as passed by @ref visitMode.
+     * \param data Block samples, the same passed to @ref analyseBlock.
+     * \param numSamples Number of samples.
+     * \param startIndex First sample to examine.
+     * \param crossingOffset Set to how many samples before the returned index the
+     * crossing happened, in [0, 1).
+     * \return int Index of the first sample after the crossing, -1 if not found.
+     */
+    template <bool falling>
+    int findCrossing(const SampleType *data, int numSamples, int startIndex, double &crossingOffset) const
+    {
+        auto previous = startIndex == 0 ? previousSample : data[startIndex - 1];
+
+        int crossing;
+        if (startIndex == 0 && hasFirstCrossing)
+        {
+            crossing = firstCrossing;
+        }
+        else
+        {
+            crossing = CrossingSearch<SampleType>::template find<falling>(data, numSamples, startIndex, threshold, previous);
+        }
+
+        if (crossing >= 0)
+        {
+            // interpolate linearly between the two samples
+            auto current = data[crossing];
+            if (crossing > startIndex)
+            {
+                previous = data[crossing - 1];
+            }
+            crossingOffset = juce::jlimit(0., 1., (double)((current - threshold) / (current - previous)));
+        }
+        return crossing;
+    }
+
+    /**
+     * Remembers the last sample of a block. Call once per block, after searching it.
+     *
+     * \param data Block samples.
+     * \param numSamples Number of samples.
+     */
+    void endBlock(const SampleType *data, int numSamples)
+    {
+        if (numSamples > 0)
+        {
+            previousSample = data[numSamples - 1];
+        }
+    }
+
+private:
+    //==============================================================================
+    static constexpr SampleType peakRelease = SampleType(0.999); /**< Per-block peak release factor */
+
+    SampleType level = SampleType(0);          /**< Trigger level */
+    SampleType peak = SampleType(0);           /**< Signal peak, used in automatic mode */
+    SampleType previousSample = SampleType(0); /**< Last sample of the previous block */
+    SampleType threshold = SampleType(0);      /**< Absolute threshold of the current block */
+    int firstCrossing = -1;                    /**< First crossing of the current block, found by analyseBlock */
+    bool hasFirstCrossing = false;             /**< Whether firstCrossing is valid */
+    bool isFalling = false;                    /**< Whether to trigger on decrescent slope */
+    bool isAutomatic = false;                  /**< Whether level is relative to peak */
+};
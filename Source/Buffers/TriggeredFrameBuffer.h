@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+    TriggeredFrameBuffer.h
+    Created: 18 Oct 2026 12:48:30pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ * Lock-free triple buffer of trigger-aligned frames.
+ *
+ * The audio thread fills the write frame and publishes it, the GUI acquires
+ * the most recently published frame and reads it in place. Neither side ever
+ * waits for the other and no sample is copied between them.
+ */
+template <typename SampleType>
+class TriggeredFrameBuffer
+{
+public:
+    //==============================================================================
+    /**
+     * A trigger-aligned multi-channel frame. Channels are stored planar.
+     */
+    struct Frame
+    {
+        juce::HeapBlock<SampleType> samples; /**< Samples of every channel */
+        size_t channelStride = 0;            /**< Distance between two channels in samples */
+        int numChannels = 0;                 /**< Number of channels */
+        size_t numSamples = 0;               /**< Number of valid samples per channel */
+        size_t triggerIndex = 0;             /**< Index of the first sample after the crossing */
+        double crossingOffset = 0.;          /**< How many samples before samples[triggerIndex] the crossing happened */
+
+        /**
+         * Get the samples of a channel.
+         *
+         * \param channel Channel index.
+         * \return SampleType* Channel samples.
+         */
+        SampleType *getChannel(int channel)
+        {
+            return samples.get() + (size_t)channel * channelStride;
+        }
+
+        /**
+         * Get the samples of a channel.
+         *
+         * \param channel Channel index.
+         * \return const SampleType* Channel samples.
+         */
+        const SampleType *getChannel(int channel) const
+        {
+            return samples.get() + (size_t)channel * channelStride;
+        }
+    };
+
+    //==============================================================================
+    /**
+     * Constructor.
+     *
+     * \param maxFrameLength Maximum number of samples per frame and channel.
+     * \param numChannelsToUse Number of channels.
+     */
+    TriggeredFrameBuffer(size_t maxFrameLength = 44100, int numChannelsToUse = 1)
+        : maxLength(maxFrameLength), numChannels(std::max(numChannelsToUse, 1))
+    {
+        for (auto &frame : frames)
+        {
+            frame.samples.calloc(maxLength * (size_t)numChannels);
+            frame.channelStride = maxLength;
+            frame.numChannels = numChannels;
+        }
+    }
+
+    /**
+     * Get the maximum number of samples per frame and channel.
+     *
+     * \return size_t Maximum frame length.
+     */
+    size_t getMaxFrameLength() const
+    {
+        return maxLength;
+    }
+
+    /**
+     * Get the number of channels of each frame.
+     *
+     * \return int Number of channels.
+     */
+    int getNumChannels() const
+    {
+        return numChannels;
+    }
+
+    //==============================================================================
+    /**
+     * Get the frame to fill. To be called from the audio thread only.
+     *
+     * \return Frame& Frame owned by the writer until publish() is called.
+     */
+    Frame &getWriteFrame()
+    {
+        return frames[writeIndex];
+    }
+
+    /**
+     * Publishes the write frame. To be called from the audio thread only.
+     *
+     */
+    void publish()
+    {
+        writeIndex = latest.exchange(writeIndex | newFrameFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    /**
+     * Acquires the most recently published frame. To be called from the GUI
+     * thread only. The frame stays untouched until the next call.
+     *
+     * \return const Frame* Latest frame, nullptr if nothing was published yet.
+     */
+    const Frame *acquireLatest()
+    {
+        // swap only if something new was published
+        if (latest.load(std::memory_order_acquire) & newFrameFlag)
+        {
+            readIndex = latest.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+            hasFrame = true;
+        }
+        return hasFrame ? &frames[readIndex] : nullptr;
+    }
+
+private:
+    //==============================================================================
+    static constexpr int newFrameFlag = 4; /**< Set on latest when it holds an unread frame */
+    static constexpr int indexMask = 3;    /**< Extracts the frame index from latest */
+
+    std::array<Frame, 3> frames;  /**< Write, latest and read frames */
+    size_t maxLength;             /**< Samples allocated per frame and channel */
+    int numChannels;              /**< Channels per frame */
+    int writeIndex = 0;           /**< Frame owned by the writer */
+    int readIndex = 1;            /**< Frame owned by the reader */
+    std::atomic<int> latest{2};   /**< Latest published frame, plus newFrameFlag */
+    bool hasFrame = false;        /**< Whether the reader ever acquired a frame */
+};
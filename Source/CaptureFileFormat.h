@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    CaptureFileFormat.h
+    Created: 19 Oct 2026 3:12:05am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Layout of a capture file, shared by CaptureFileWriter and CaptureFileReader.
+ *
+ * A capture file holds, each section starting on a page boundary:
+ * - the header below, padded to headerSize bytes,
+ * - the raw samples as interleaved 32-bit floats,
+ * - the summary levels, level k holding the min & max of every channel over
+ *   each span of baseBucketSize * decimationFactor^k frames, interleaved as
+ *   min & max per channel,
+ * - the timestamp table, one Timestamp per written chunk.
+ *
+ * Everything is little-endian, so that every section can be used in place from
+ * a memory mapping on the platforms the plugin is built for.
+ *
+ * An interrupted recording keeps the provisional header, with no sections, and
+ * the samples written so far, from which the summaries can be rebuilt.
+ */
+namespace CaptureFileFormat
+{
+  static constexpr char magic[8] = {'O', 'S', 'C', 'C', 'A', 'P', 'T', '1'}; /**< Identifies a complete capture file */
+  static constexpr juce::uint32 version = 1;                                  /**< Layout version */
+  static constexpr const char *fileExtension = ".oscap";                      /**< Extension of capture files */
+  static constexpr int maxLevels = 8;                                         /**< Levels the header has room for */
+  static constexpr juce::uint32 baseBucketSize = 256;                         /**< Frames summarised by a level 0 entry */
+  static constexpr juce::uint32 decimationFactor = 8;                         /**< Entries of a level merged into one entry of the next */
+  static constexpr juce::int64 headerSize = 4096;                             /**< Bytes before the samples */
+  static constexpr juce::int64 pageSize = 4096;                               /**< Alignment of every section */
+
+  /**
+   * File header. Written first without sections, i.e. with timestampsOffset
+   * and numFrames zero, and completed last. numFrames alone is set when the
+   * sections could not be appended.
+   */
+  struct Header
+  {
+    char magic[8];                            /**< @ref CaptureFileFormat::magic */
+    juce::uint32 version;                     /**< @ref CaptureFileFormat::version */
+    juce::uint32 numChannels;                 /**< Interleaved channels */
+    double sampleRate;                        /**< Sample rate */
+    juce::uint64 numFrames;                   /**< Frames of samples */
+    juce::uint32 baseBucketSize;              /**< Frames summarised by a level 0 entry */
+    juce::uint32 decimationFactor;            /**< Entries of a level per entry of the next */
+    juce::uint32 numLevels;                   /**< Summary levels stored */
+    juce::uint32 numTimestamps;               /**< Entries of the timestamp table */
+    juce::uint64 samplesOffset;               /**< File offset of the samples */
+    juce::uint64 levelOffsets[maxLevels];     /**< File offset of each level */
+    juce::uint64 levelNumEntries[maxLevels];  /**< Entries of each level */
+    juce::uint64 timestampsOffset;            /**< File offset of the timestamp table */
+  };
+
+  /**
+   * Wall-clock time at which a frame was written.
+   */
+  struct Timestamp
+  {
+    juce::uint64 frame;                       /**< Frame the entry refers to */
+    juce::int64 milliseconds;                 /**< Milliseconds since 1970 when the frame was captured */
+    juce::uint64 numDroppedFrames;            /**< Frames lost to overruns before the frame */
+  };
+
+  static_assert(std::is_trivially_copyable<Header>::value && sizeof(Header) <= headerSize, "header must fit its page");
+  static_assert(sizeof(Timestamp) == 24, "timestamps must not be padded");
+
+  /**
+   * Get the frames summarised by one entry of a level.
+   *
+   * \param level Level index.
+   * \return juce::uint64 Frames per entry.
+   */
+  inline juce::uint64 getFramesPerEntry(int level)
+  {
+    juce::uint64 frames = baseBucketSize;
+    for (int i = 0; i < level; ++i)
+    {
+      frames *= decimationFactor;
+    }
+    return frames;
+  }
+
+  /**
+   * Rounds an offset up to the next page boundary.
+   *
+   * \param offset File offset.
+   * \return juce::int64 Aligned offset.
+   */
+  inline juce::int64 alignToPage(juce::int64 offset)
+  {
+    return (offset + pageSize - 1) / pageSize * pageSize;
+  }
+}
@@ -0,0 +1,246 @@
+/*
+  ==============================================================================
+
+    CaptureFileReader.cpp
+    Created: 19 Oct 2026 3:12:05am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "CaptureFileReader.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+CaptureFileReader::CaptureFileReader(const juce::File &file)
+    : mapping(new juce::MemoryMappedFile(file, juce::MemoryMappedFile::readOnly))
+{
+  auto data = static_cast<const char *>(mapping->getData());
+  auto size = (juce::uint64)mapping->getSize();
+  if (data == nullptr || size < (juce::uint64)CaptureFileFormat::headerSize)
+  {
+    mapping.reset();
+    return;
+  }
+  std::memcpy(&header, data, sizeof(header));
+
+  // reject foreign files before pointing into them
+  auto fits = [size](juce::uint64 offset, juce::uint64 numItems, juce::uint64 itemSize)
+  {
+    return offset <= size && offset % sizeof(juce::uint64) == 0 && numItems <= (size - offset) / itemSize;
+  };
+  auto isCapture = std::memcmp(header.magic, CaptureFileFormat::magic, sizeof(header.magic)) == 0 &&
+                   header.version == CaptureFileFormat::version &&
+                   header.numChannels > 0 &&
+                   header.sampleRate > 0. &&
+                   header.baseBucketSize == CaptureFileFormat::baseBucketSize &&
+                   header.decimationFactor == CaptureFileFormat::decimationFactor &&
+                   fits(header.samplesOffset, 0, 1);
+  if (!isCapture)
+  {
+    mapping.reset();
+    return;
+  }
+
+  // interrupted & truncated files only have their samples
+  auto isComplete = header.timestampsOffset != 0 &&
+                    header.numLevels <= (juce::uint32)CaptureFileFormat::maxLevels &&
+                    fits(header.samplesOffset, header.numFrames, sizeof(float) * header.numChannels) &&
+                    fits(header.timestampsOffset, header.numTimestamps, sizeof(CaptureFileFormat::Timestamp));
+  for (juce::uint32 level = 0; isComplete && level < header.numLevels; ++level)
+  {
+    // every frame must be covered by an entry
+    auto framesPerEntry = CaptureFileFormat::getFramesPerEntry((int)level);
+    isComplete = header.levelNumEntries[level] == (header.numFrames + framesPerEntry - 1) / framesPerEntry &&
+                 fits(header.levelOffsets[level], header.levelNumEntries[level], 2 * sizeof(float) * header.numChannels);
+  }
+
+  // sections are used in place
+  samples = reinterpret_cast<const float *>(data + header.samplesOffset);
+  if (!isComplete)
+  {
+    recover(size);
+    return;
+  }
+  for (juce::uint32 level = 0; level < header.numLevels; ++level)
+  {
+    levels[level] = reinterpret_cast<const float *>(data + header.levelOffsets[level]);
+  }
+  timestamps = reinterpret_cast<const CaptureFileFormat::Timestamp *>(data + header.timestampsOffset);
+}
+
+bool CaptureFileReader::isValid() const
+{
+  return mapping != nullptr;
+}
+
+bool CaptureFileReader::isRecovered() const
+{
+  return isValid() && !recoveredLevels.empty();
+}
+
+int CaptureFileReader::getNumChannels() const
+{
+  return isValid() ? (int)header.numChannels : 0;
+}
+
+double CaptureFileReader::getSampleRate() const
+{
+  return isValid() ? header.sampleRate : 44100.;
+}
+
+juce::int64 CaptureFileReader::getNumFrames() const
+{
+  return isValid() ? (juce::int64)header.numFrames : 0;
+}
+
+void CaptureFileReader::render(int channel, double startFrame, double numSpanFrames, int numColumns, float *minOutput, float *maxOutput) const
+{
+  jassert(!isValid() || (channel >= 0 && channel < getNumChannels()));
+  if (!isValid() || numColumns <= 0 || channel < 0 || channel >= getNumChannels())
+  {
+    std::fill(minOutput, minOutput + std::max(numColumns, 0), 0.f);
+    std::fill(maxOutput, maxOutput + std::max(numColumns, 0), 0.f);
+    return;
+  }
+
+  // coarsest level with entries no longer than a column, -1 for raw samples
+  auto framesPerColumn = numSpanFrames / numColumns;
+  int level = -1;
+  while (level + 1 < (int)header.numLevels && (double)CaptureFileFormat::getFramesPerEntry(level + 1) <= framesPerColumn)
+  {
+    ++level;
+  }
+
+  auto numChannels = (juce::int64)header.numChannels;
+  auto numFrames = (double)header.numFrames;
+  for (int column = 0; column < numColumns; ++column)
+  {
+    // frames the column overlaps, nothing outside the capture
+    auto begin = std::max(0., startFrame + column * framesPerColumn);
+    auto end = std::min(numFrames, startFrame + (column + 1) * framesPerColumn);
+    auto first = (juce::int64)begin;
+    auto last = (juce::int64)std::ceil(end);
+    if (end <= begin || last <= first)
+    {
+      minOutput[column] = 0.f;
+      maxOutput[column] = 0.f;
+      continue;
+    }
+
+    auto low = std::numeric_limits<float>::max();
+    auto high = std::numeric_limits<float>::lowest();
+    if (level < 0)
+    {
+      // fewer frames than a level 0 entry, strided through the interleaved samples
+      auto sample = samples + first * numChannels + channel;
+      for (auto frame = first; frame < last; ++frame, sample += numChannels)
+      {
+        low = std::min(low, *sample);
+        high = std::max(high, *sample);
+      }
+    }
+    else
+    {
+      // the entries overlapping the column, at most decimationFactor + 1
+      auto framesPerEntry = (juce::int64)CaptureFileFormat::getFramesPerEntry(level);
+      auto firstEntry = first / framesPerEntry;
+      auto endEntry = (last + framesPerEntry - 1) / framesPerEntry;
+      auto entry = levels[level] + (firstEntry * numChannels + channel) * 2;
+      for (auto index = firstEntry; index < endEntry; ++index, entry += 2 * numChannels)
+      {
+        low = std::min(low, entry[0]);
+        high = std::max(high, entry[1]);
+      }
+    }
+    minOutput[column] = low;
+    maxOutput[column] = high;
+  }
+}
+
+juce::Time CaptureFileReader::getTimeOfFrame(juce::int64 frame) const
+{
+  if (!isValid() || header.numTimestamps == 0)
+  {
+    return juce::Time();
+  }
+
+  // the preceding entry, or the first one, advanced at the sample rate
+  auto &entry = timestamps[std::max(0, findTimestamp(frame))];
+  auto offsetSeconds = double(frame - (juce::int64)entry.frame) / header.sampleRate;
+  return juce::Time(entry.milliseconds + (juce::int64)(offsetSeconds * 1000.));
+}
+
+juce::uint64 CaptureFileReader::getNumDroppedFramesBefore(juce::int64 frame) const
+{
+  auto index = findTimestamp(frame);
+  return index < 0 ? 0 : timestamps[index].numDroppedFrames;
+}
+
+void CaptureFileReader::recover(juce::uint64 size)
+{
+  // the frames written, or those counted when the sections went missing
+  auto numChannels = (juce::uint64)header.numChannels;
+  auto numWrittenFrames = (size - header.samplesOffset) / (sizeof(float) * numChannels);
+  header.numFrames = header.numFrames > 0 && header.numFrames <= numWrittenFrames ? header.numFrames : numWrittenFrames;
+  header.numTimestamps = 0;
+  header.timestampsOffset = 0;
+
+  // levels down to the first one with a single entry, as written
+  header.numLevels = 0;
+  size_t numValues = 0;
+  while (header.numFrames > 0 && header.numLevels < (juce::uint32)CaptureFileFormat::maxLevels)
+  {
+    auto framesPerEntry = CaptureFileFormat::getFramesPerEntry((int)header.numLevels);
+    header.levelNumEntries[header.numLevels] = (header.numFrames + framesPerEntry - 1) / framesPerEntry;
+    numValues += (size_t)(header.levelNumEntries[header.numLevels] * numChannels * 2);
+    if (header.levelNumEntries[header.numLevels++] <= 1)
+    {
+      break;
+    }
+  }
+
+  // one pass over the samples for level 0, each level merges the one below
+  recoveredLevels.resize(std::max<size_t>(numValues, 1));
+  auto destination = recoveredLevels.data();
+  for (juce::uint32 level = 0; level < header.numLevels; ++level)
+  {
+    levels[level] = destination;
+    auto numSources = level == 0 ? header.numFrames : header.levelNumEntries[level - 1];
+    auto sourcesPerEntry = (juce::uint64)(level == 0 ? CaptureFileFormat::baseBucketSize : CaptureFileFormat::decimationFactor);
+    for (juce::uint64 entry = 0; entry < header.levelNumEntries[level]; ++entry, destination += 2 * numChannels)
+    {
+      for (juce::uint64 channel = 0; channel < numChannels; ++channel)
+      {
+        destination[2 * channel] = std::numeric_limits<float>::max();
+        destination[2 * channel + 1] = std::numeric_limits<float>::lowest();
+      }
+      auto end = std::min(numSources, (entry + 1) * sourcesPerEntry);
+      for (auto source = entry * sourcesPerEntry; source < end; ++source)
+      {
+        for (juce::uint64 channel = 0; channel < numChannels; ++channel)
+        {
+          auto low = level == 0 ? samples[source * numChannels + channel] : levels[level - 1][(source * numChannels + channel) * 2];
+          auto high = level == 0 ? low : levels[level - 1][(source * numChannels + channel) * 2 + 1];
+          destination[2 * channel] = std::min(destination[2 * channel], low);
+          destination[2 * channel + 1] = std::max(destination[2 * channel + 1], high);
+        }
+      }
+    }
+  }
+}
+
+int CaptureFileReader::findTimestamp(juce::int64 frame) const
+{
+  if (!isValid() || header.numTimestamps == 0)
+  {
+    return -1;
+  }
+
+  // entries are sorted by frame
+  auto end = timestamps + header.numTimestamps;
+  auto next = std::upper_bound(timestamps, end, frame, [](juce::int64 value, const CaptureFileFormat::Timestamp &entry)
+                               { return value < (juce::int64)entry.frame; });
+  return (int)(next - timestamps) - 1;
+}
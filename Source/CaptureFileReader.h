@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    CaptureFileReader.h
+    Created: 19 Oct 2026 3:12:05am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include "CaptureFileFormat.h"
+
+/**
+ * Reads a capture file, see @ref CaptureFileFormat, through a
+ * juce::MemoryMappedFile.
+ *
+ * Nothing is read up front: the operating system loads the pages a render
+ * touches, and rendering any span of the file into a number of columns reads
+ * a bounded number of samples or summary entries per column, whatever the
+ * span and the file size. An interrupted recording is read once on opening,
+ * to rebuild its summaries.
+ */
+class CaptureFileReader
+{
+public:
+  /**
+   * Construct a new Capture File Reader object
+   *
+   * \param file Capture file to map.
+   */
+  explicit CaptureFileReader(const juce::File &file);
+
+  /**
+   * Returns whether the file is a capture file, complete or recovered.
+   *
+   * \return true if it can be read.
+   * \return false otherwise.
+   */
+  bool isValid() const;
+
+  /**
+   * Returns whether the file is an interrupted recording, whose summaries were
+   * rebuilt from its samples and which has no timestamps.
+   *
+   * \return true if recovered.
+   * \return false otherwise.
+   */
+  bool isRecovered() const;
+
+  /**
+   * Get the number of channels.
+   *
+   * \return int Channels per frame.
+   */
+  int getNumChannels() const;
+
+  /**
+   * Get the sample rate.
+   *
+   * \return double Sample rate.
+   */
+  double getSampleRate() const;
+
+  /**
+   * Get the length of the capture.
+   *
+   * \return juce::int64 Number of frames.
+   */
+  juce::int64 getNumFrames() const;
+
+  /**
+   * Renders a span of a channel into columns, the min & max of the frames
+   * each covers. Columns outside the capture are set to 0.
+   *
+   * Reads raw samples when a column covers less than a level 0 entry, and the
+   * coarsest level with entries no longer than a column otherwise, i.e. at
+   * most decimationFactor + 1 entries per column.
+   *
+   * \param channel Channel index.
+   * \param startFrame First frame of the span, may be fractional.
+   * \param numSpanFrames Frames in the span.
+   * \param numColumns Number of columns to render.
+   * \param minOutput Where to write the minimum of each column.
+   * \param maxOutput Where to write the maximum of each column.
+   */
+  void render(int channel, double startFrame, double numSpanFrames, int numColumns, float *minOutput, float *maxOutput) const;
+
+  /**
+   * Get the wall-clock time at which a frame was captured, from the preceding
+   * entry of the timestamp table advanced at the sample rate.
+   *
+   * \param frame Frame index.
+   * \return juce::Time Capture time, or the epoch if the file has no timestamps.
+   */
+  juce::Time getTimeOfFrame(juce::int64 frame) const;
+
+  /**
+   * Get the number of frames lost to overruns before a frame.
+   *
+   * \param frame Frame index.
+   * \return juce::uint64 Frames dropped before the entry preceding frame.
+   */
+  juce::uint64 getNumDroppedFramesBefore(juce::int64 frame) const;
+
+private:
+  std::unique_ptr<juce::MemoryMappedFile> mapping;            /**< Whole file, paged in on access */
+  CaptureFileFormat::Header header{};                         /**< Copy of the header */
+  const float *samples = nullptr;                             /**< Interleaved samples */
+  const float *levels[CaptureFileFormat::maxLevels] = {};     /**< Min & max entries of each level */
+  const CaptureFileFormat::Timestamp *timestamps = nullptr;   /**< Timestamp table */
+  std::vector<float> recoveredLevels;                         /**< Levels rebuilt for an interrupted recording */
+
+  /**
+   * Rebuilds the summary levels of an interrupted recording from its samples,
+   * in memory, reading the whole file once.
+   *
+   * \param size File size.
+   */
+  void recover(juce::uint64 size);
+
+  /**
+   * Get the timestamp table entry preceding a frame.
+   *
+   * \param frame Frame index.
+   * \return int Entry index, -1 if there is none.
+   */
+  int findTimestamp(juce::int64 frame) const;
+};
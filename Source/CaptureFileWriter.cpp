@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+    CaptureFileWriter.cpp
+    Created: 19 Oct 2026 3:12:05am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "CaptureFileWriter.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+CaptureFileWriter::CaptureFileWriter(juce::OutputStream *destStream, const juce::File &file, double newSampleRate, unsigned int newNumChannels)
+    : AudioFormatWriter(destStream, "Oscilloscope Capture", newSampleRate, newNumChannels, 32)
+{
+  usesFloatingPointData = true;
+
+  // empty entries everywhere, each section in a hidden file of its own
+  levels.resize(CaptureFileFormat::maxLevels);
+  for (size_t level = 0; level < levels.size(); ++level)
+  {
+    clearEntry(levels[level].accumulator);
+    levels[level].entries.file = file.getSiblingFile("." + file.getFileName() + ".level" + juce::String((int)level));
+  }
+  clearEntry(bucket);
+  timestamps.file = file.getSiblingFile("." + file.getFileName() + ".timestamps");
+
+  // provisional header, completed once the sections are known
+  auto header = makeHeader();
+  output->write(&header, sizeof(header));
+  output->writeRepeatedByte(0, (size_t)CaptureFileFormat::headerSize - sizeof(header));
+}
+
+CaptureFileWriter::~CaptureFileWriter()
+{
+  // partial entries, from the finest level up so that they cascade
+  if (numBucketFrames > 0)
+  {
+    appendEntry(0, bucket.data());
+  }
+  for (int level = 1; level < CaptureFileFormat::maxLevels; ++level)
+  {
+    if (levels[(size_t)level].numAccumulated > 0)
+    {
+      appendEntry(level, levels[(size_t)level].accumulator.data());
+    }
+  }
+
+  // levels down to the first one with a single entry, coarser ones add nothing
+  auto header = makeHeader();
+  while (header.numLevels < (juce::uint32)CaptureFileFormat::maxLevels && levels[header.numLevels].entries.numItems > 0)
+  {
+    ++header.numLevels;
+    if (levels[header.numLevels - 1].entries.numItems <= 1)
+    {
+      break;
+    }
+  }
+
+  // each section on its own page after the samples
+  if (!sectionsFailed)
+  {
+    for (juce::uint32 level = 0; level < header.numLevels; ++level)
+    {
+      header.levelNumEntries[level] = levels[level].entries.numItems;
+      header.levelOffsets[level] = copySection(levels[level].entries);
+    }
+    header.numTimestamps = (juce::uint32)timestamps.numItems;
+    header.timestampsOffset = copySection(timestamps);
+  }
+
+  // complete the header, or only count the frames for recovery if a section is missing
+  if (sectionsFailed)
+  {
+    header = makeHeader();
+  }
+  header.numFrames = numFrames;
+  output->setPosition(0);
+  output->write(&header, sizeof(header));
+  output->flush();
+
+  // nothing is left next to the capture
+  for (auto &level : levels)
+  {
+    level.entries.stream.reset();
+    level.entries.file.deleteFile();
+  }
+  timestamps.stream.reset();
+  timestamps.file.deleteFile();
+}
+
+bool CaptureFileWriter::write(const int **samplesToWrite, int numSamples)
+{
+  if (numSamples <= 0)
+  {
+    return true;
+  }
+  auto channels = reinterpret_cast<const float *const *>(samplesToWrite);
+
+  // the channel list may end early, the rest is silent
+  auto numSourceChannels = 0;
+  while (numSourceChannels < (int)numChannels && channels[numSourceChannels] != nullptr)
+  {
+    ++numSourceChannels;
+  }
+
+  // interleave, growing the buffer on the first large chunk only
+  if (numSamples > interleavedCapacity)
+  {
+    interleaved.malloc((size_t)numSamples * numChannels);
+    interleavedCapacity = numSamples;
+  }
+  for (int channel = 0; channel < (int)numChannels; ++channel)
+  {
+    auto destination = interleaved.get() + channel;
+    for (int i = 0; i < numSamples; ++i)
+    {
+      destination[(size_t)i * numChannels] = channel < numSourceChannels ? channels[channel][i] : 0.f;
+    }
+  }
+
+  // summarise a bucket span at a time
+  int done = 0;
+  while (done < numSamples)
+  {
+    auto span = std::min(numSamples - done, (int)(CaptureFileFormat::baseBucketSize - numBucketFrames));
+    for (int channel = 0; channel < numSourceChannels; ++channel)
+    {
+      auto range = juce::FloatVectorOperations::findMinAndMax(channels[channel] + done, span);
+      bucket[2 * (size_t)channel] = std::min(bucket[2 * (size_t)channel], range.getStart());
+      bucket[2 * (size_t)channel + 1] = std::max(bucket[2 * (size_t)channel + 1], range.getEnd());
+    }
+    for (int channel = numSourceChannels; channel < (int)numChannels; ++channel)
+    {
+      bucket[2 * (size_t)channel] = std::min(bucket[2 * (size_t)channel], 0.f);
+      bucket[2 * (size_t)channel + 1] = std::max(bucket[2 * (size_t)channel + 1], 0.f);
+    }
+    numBucketFrames += (juce::uint32)span;
+    done += span;
+
+    // bucket complete, push it up the levels
+    if (numBucketFrames == CaptureFileFormat::baseBucketSize)
+    {
+      appendEntry(0, bucket.data());
+      clearEntry(bucket);
+      numBucketFrames = 0;
+    }
+  }
+
+  numFrames += (juce::uint64)numSamples;
+  return output->write(interleaved.get(), (size_t)numSamples * numChannels * sizeof(float));
+}
+
+void CaptureFileWriter::addTimestamp(juce::int64 milliseconds, juce::uint64 numDroppedFrames)
+{
+  CaptureFileFormat::Timestamp timestamp{numFrames, milliseconds, numDroppedFrames};
+  appendToSection(timestamps, &timestamp, sizeof(timestamp));
+}
+
+CaptureFileFormat::Header CaptureFileWriter::makeHeader() const
+{
+  // no sections yet, see CaptureFileFormat::Header
+  CaptureFileFormat::Header header{};
+  std::memcpy(header.magic, CaptureFileFormat::magic, sizeof(header.magic));
+  header.version = CaptureFileFormat::version;
+  header.numChannels = numChannels;
+  header.sampleRate = sampleRate;
+  header.baseBucketSize = CaptureFileFormat::baseBucketSize;
+  header.decimationFactor = CaptureFileFormat::decimationFactor;
+  header.samplesOffset = (juce::uint64)CaptureFileFormat::headerSize;
+  return header;
+}
+
+void CaptureFileWriter::appendToSection(Section &section, const void *data, size_t numBytes)
+{
+  if (sectionsFailed)
+  {
+    return;
+  }
+
+  // replace what an interrupted recording may have left
+  if (section.stream == nullptr)
+  {
+    section.file.deleteFile();
+    section.stream.reset(new juce::FileOutputStream(section.file));
+  }
+  sectionsFailed = !section.stream->openedOk() || !section.stream->write(data, numBytes);
+  ++section.numItems;
+}
+
+juce::uint64 CaptureFileWriter::copySection(Section &section)
+{
+  // pad to the next page
+  auto position = output->getPosition();
+  output->writeRepeatedByte(0, (size_t)(CaptureFileFormat::alignToPage(position) - position));
+  auto offset = (juce::uint64)output->getPosition();
+  if (sectionsFailed || section.stream == nullptr)
+  {
+    return offset;
+  }
+
+  // close the section file, then stream it in
+  section.stream->flush();
+  auto expectedBytes = section.stream->getPosition();
+  section.stream.reset();
+  juce::FileInputStream input(section.file);
+  sectionsFailed = !input.openedOk() || output->writeFromInputStream(input, -1) != expectedBytes;
+  return offset;
+}
+
+void CaptureFileWriter::appendEntry(int level, const float *entry)
+{
+  auto &current = levels[(size_t)level];
+  appendToSection(current.entries, entry, 2 * (size_t)numChannels * sizeof(float));
+
+  // merge into the next level, complete after decimationFactor entries
+  if (level + 1 < CaptureFileFormat::maxLevels)
+  {
+    auto &next = levels[(size_t)level + 1];
+    mergeEntry(next.accumulator, entry);
+    if (++next.numAccumulated == CaptureFileFormat::decimationFactor)
+    {
+      appendEntry(level + 1, next.accumulator.data());
+      clearEntry(next.accumulator);
+      next.numAccumulated = 0;
+    }
+  }
+}
+
+void CaptureFileWriter::clearEntry(std::vector<float> &entry) const
+{
+  entry.resize(2 * (size_t)numChannels);
+  for (size_t channel = 0; channel < numChannels; ++channel)
+  {
+    entry[2 * channel] = std::numeric_limits<float>::max();
+    entry[2 * channel + 1] = std::numeric_limits<float>::lowest();
+  }
+}
+
+void CaptureFileWriter::mergeEntry(std::vector<float> &entry, const float *other) const
+{
+  for (size_t channel = 0; channel < numChannels; ++channel)
+  {
+    entry[2 * channel] = std::min(entry[2 * channel], other[2 * channel]);
+    entry[2 * channel + 1] = std::max(entry[2 * channel + 1], other[2 * channel + 1]);
+  }
+}
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    CaptureFileWriter.h
+    Created: 19 Oct 2026 3:12:05am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include "CaptureFileFormat.h"
+
+/**
+ * Writes a capture file, see @ref CaptureFileFormat.
+ *
+ * Samples are streamed to the file as they come, after a provisional header
+ * from which CaptureFileReader recovers an interrupted recording. The summary
+ * levels and the timestamp table are built on the way and streamed to hidden
+ * section files next to the capture, so that memory use stays bounded
+ * however long the recording. They are appended, and the header completed,
+ * when the writer is destroyed, like the header of a juce::WavAudioFormat
+ * writer.
+ */
+class CaptureFileWriter : public juce::AudioFormatWriter
+{
+public:
+  /**
+   * Construct a new Capture File Writer object
+   *
+   * \param destStream Stream to write to, positioned at its start. Owned by the writer.
+   * \param file File destStream writes, the section files are created next to it.
+   * \param newSampleRate Sample rate.
+   * \param newNumChannels Channels per frame.
+   */
+  CaptureFileWriter(juce::OutputStream *destStream, const juce::File &file, double newSampleRate, unsigned int newNumChannels);
+
+  /**
+   * Appends the summary levels and the timestamp table, completes the header
+   * and deletes the section files. If a section file failed, the provisional
+   * header is left so that the samples can still be recovered.
+   *
+   */
+  ~CaptureFileWriter() override;
+
+  /**
+   * Appends frames. Use writeFromFloatArrays, the writer takes float data.
+   *
+   * \param samplesToWrite Float channels, cast as by juce::AudioFormatWriter.
+   * \param numSamples Frames to write.
+   * \return true if the stream accepted them.
+   * \return false otherwise.
+   */
+  bool write(const int **samplesToWrite, int numSamples) override;
+
+  /**
+   * Records the wall-clock time of the next frame to be written.
+   *
+   * \param milliseconds Milliseconds since 1970 when that frame was captured.
+   * \param numDroppedFrames Frames lost before it since the start.
+   */
+  void addTimestamp(juce::int64 milliseconds, juce::uint64 numDroppedFrames);
+
+private:
+  /**
+   * A section streamed to a file of its own until it is appended.
+   */
+  struct Section
+  {
+    juce::File file;                                  /**< Hidden file next to the capture */
+    std::unique_ptr<juce::FileOutputStream> stream;   /**< Open on the first item */
+    juce::uint64 numItems = 0;                        /**< Items written */
+  };
+
+  /**
+   * One summary level, min & max per channel for each entry.
+   */
+  struct Level
+  {
+    Section entries;                 /**< Complete entries */
+    std::vector<float> accumulator;  /**< Entry being merged from the level below */
+    juce::uint32 numAccumulated = 0; /**< Entries of the level below merged into it */
+  };
+
+  juce::uint64 numFrames = 0;                                   /**< Frames written */
+  std::vector<Level> levels;                                    /**< Summary levels */
+  std::vector<float> bucket;                                    /**< Level 0 entry being accumulated */
+  juce::uint32 numBucketFrames = 0;                             /**< Frames in bucket */
+  Section timestamps;                                           /**< Timestamp table */
+  bool sectionsFailed = false;                                  /**< Whether a section file could not be written */
+  juce::HeapBlock<float> interleaved;                           /**< Frames being written */
+  int interleavedCapacity = 0;                                  /**< Frames interleaved fits */
+
+  /**
+   * Get a header with every field known before the first frame.
+   *
+   * \return CaptureFileFormat::Header Provisional header.
+   */
+  CaptureFileFormat::Header makeHeader() const;
+
+  /**
+   * Appends an item to a section file, opening it first if needed.
+   *
+   * \param section Section to append to.
+   * \param data Item.
+   * \param numBytes Size of the item.
+   */
+  void appendToSection(Section &section, const void *data, size_t numBytes);
+
+  /**
+   * Appends a section file to the capture and deletes it.
+   *
+   * \param section Section to append.
+   * \return juce::uint64 File offset of the section, on a page boundary.
+   */
+  juce::uint64 copySection(Section &section);
+
+  /**
+   * Appends an entry to a level and merges it into the next one.
+   *
+   * \param level Level index.
+   * \param entry Min & max per channel.
+   */
+  void appendEntry(int level, const float *entry);
+
+  /**
+   * Resets an entry to no samples seen.
+   *
+   * \param entry Entry to reset.
+   */
+  void clearEntry(std::vector<float> &entry) const;
+
+  /**
+   * Widens an entry to cover another one.
+   *
+   * \param entry Entry to widen.
+   * \param other Entry to cover.
+   */
+  void mergeEntry(std::vector<float> &entry, const float *other) const;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CaptureFileWriter)
+};
@@ -0,0 +1,334 @@
+/*
+  ==============================================================================
+
+    CaptureRecorder.cpp
+    Created: 19 Oct 2026 2:06:41am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "CaptureRecorder.h"
+#include <algorithm>
+
+#if JUCE_LINUX || JUCE_MAC
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+CaptureRecorder::CaptureRecorder()
+{
+}
+
+CaptureRecorder::~CaptureRecorder()
+{
+  // the writer thread may not get to close the file before it stops, close it here
+  stop();
+  writerThread.removeTimeSliceClient(this);
+  if (closing.load(std::memory_order_acquire))
+  {
+    closeFile();
+  }
+  writerThread.stopThread(1000);
+}
+
+void CaptureRecorder::prepare(double newSampleRate, int newNumChannels)
+{
+  // a file keeps the format it was started with
+  const juce::ScopedLock lock(controlLock);
+  if (newSampleRate != sampleRate || newNumChannels != numChannels)
+  {
+    requestClose();
+  }
+  sampleRate = newSampleRate;
+  numChannels = std::max(1, newNumChannels);
+}
+
+bool CaptureRecorder::start(const juce::File &file)
+{
+  // the writer thread owns the previous file until it has closed it, and
+  // stays idle until recording is set
+  const juce::ScopedLock lock(controlLock);
+  if (isRecording() || closing.load(std::memory_order_acquire))
+  {
+    return false;
+  }
+  recordingNumChannels = numChannels;
+
+  // open the file, 32 bits being float samples for WAV
+  file.getParentDirectory().createDirectory();
+  file.deleteFile();
+  auto stream = file.createOutputStream();
+  if (stream == nullptr)
+  {
+    return false;
+  }
+  captureWriter = nullptr;
+  if (file.hasFileExtension(CaptureFileFormat::fileExtension))
+  {
+    captureWriter = new CaptureFileWriter(stream.release(), file, sampleRate, (unsigned int)numChannels);
+    writer.reset(captureWriter);
+  }
+  else
+  {
+    juce::WavAudioFormat format;
+    writer.reset(format.createWriterFor(stream.get(), sampleRate, (unsigned int)numChannels, 32, {}, 0));
+    if (writer == nullptr)
+    {
+      return false;
+    }
+    stream.release();
+  }
+  recordingFile = file;
+
+  // allocate the ring when the format changed, the audio thread only uses it
+  // while recording and prepare is never concurrent with it
+  auto capacity = std::max(4 * chunkLength, juce::nextPowerOfTwo((int)(sampleRate * ringSeconds)));
+  if (ring.size() != (size_t)numChannels || fifo.getTotalSize() != capacity)
+  {
+    ring.assign((size_t)numChannels, std::vector<float>((size_t)capacity));
+    chunkPointers.resize(ring.size());
+    fifo.setTotalSize(capacity);
+  }
+
+  // leftovers of a block pushed while the previous recording stopped
+  fifo.finishedRead(fifo.getNumReady());
+
+  // reserve disk space through a handle of our own, the writer owns its stream
+#if JUCE_LINUX || JUCE_MAC
+  reservationDescriptor = open(file.getFullPathName().toRawUTF8(), O_WRONLY);
+#endif
+  reservedBytes = 0;
+  reserveUpTo(reservationBytes);
+
+  // reset counters
+  numWrittenSamples.store(0, std::memory_order_relaxed);
+  numWrittenBytes.store(0, std::memory_order_relaxed);
+  writeNanoseconds.store(0, std::memory_order_relaxed);
+  numOverruns.store(0, std::memory_order_relaxed);
+  numDroppedSamples.store(0, std::memory_order_relaxed);
+  maxFill.store(0., std::memory_order_relaxed);
+  recordingSampleRate.store(sampleRate, std::memory_order_relaxed);
+
+  // feed the ring and drain it, the client stays registered between recordings
+  recording.store(true, std::memory_order_release);
+  if (!writerThread.isThreadRunning())
+  {
+    writerThread.startThread();
+  }
+  writerThread.addTimeSliceClient(this);
+  return true;
+}
+
+void CaptureRecorder::stop()
+{
+  const juce::ScopedLock lock(controlLock);
+  requestClose();
+}
+
+bool CaptureRecorder::isClosing() const
+{
+  return closing.load(std::memory_order_acquire);
+}
+
+bool CaptureRecorder::isRecording() const
+{
+  return recording.load(std::memory_order_acquire);
+}
+
+void CaptureRecorder::push(const float *const *data, int numDataChannels, int numSamples)
+{
+  if (!recording.load(std::memory_order_acquire))
+  {
+    return;
+  }
+
+  // a partial block would hide the gap in the file
+  if (fifo.getFreeSpace() < numSamples)
+  {
+    numOverruns.fetch_add(1, std::memory_order_relaxed);
+    numDroppedSamples.fetch_add((juce::uint64)numSamples, std::memory_order_relaxed);
+    return;
+  }
+
+  // copy each channel, silence for the missing ones
+  int start1, size1, start2, size2;
+  fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+  for (size_t channel = 0; channel < ring.size(); ++channel)
+  {
+    auto destination = ring[channel].data();
+    if ((int)channel < numDataChannels)
+    {
+      juce::FloatVectorOperations::copy(destination + start1, data[channel], size1);
+      juce::FloatVectorOperations::copy(destination + start2, data[channel] + size1, size2);
+    }
+    else
+    {
+      juce::FloatVectorOperations::clear(destination + start1, size1);
+      juce::FloatVectorOperations::clear(destination + start2, size2);
+    }
+  }
+  fifo.finishedWrite(size1 + size2);
+
+  // only the audio thread writes the maximum
+  auto fill = double(fifo.getNumReady()) / double(fifo.getTotalSize());
+  if (fill > maxFill.load(std::memory_order_relaxed))
+  {
+    maxFill.store(fill, std::memory_order_relaxed);
+  }
+}
+
+RecorderSnapshot CaptureRecorder::getSnapshot() const
+{
+  RecorderSnapshot snapshot;
+  snapshot.isRecording = isRecording();
+  snapshot.isClosing = isClosing();
+  snapshot.numWrittenSamples = numWrittenSamples.load(std::memory_order_relaxed);
+  snapshot.numWrittenBytes = numWrittenBytes.load(std::memory_order_relaxed);
+  snapshot.writeSeconds = (double)writeNanoseconds.load(std::memory_order_relaxed) * 1.0e-9;
+  snapshot.numOverruns = numOverruns.load(std::memory_order_relaxed);
+  snapshot.numDroppedSamples = numDroppedSamples.load(std::memory_order_relaxed);
+  snapshot.maxFill = maxFill.load(std::memory_order_relaxed);
+  snapshot.sampleRate = recordingSampleRate.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+juce::File CaptureRecorder::getDefaultFile()
+{
+  auto name = "Capture " + juce::Time::getCurrentTime().formatted("%Y-%m-%d %H-%M-%S") + CaptureFileFormat::fileExtension;
+  return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+      .getChildFile("Oscilloscope")
+      .getChildFile(name)
+      .getNonexistentSibling();
+}
+
+void CaptureRecorder::requestClose()
+{
+  if (!isRecording())
+  {
+    return;
+  }
+
+  // stop feeding, the writer thread drains the rest and closes the file
+  recording.store(false, std::memory_order_release);
+  closing.store(true, std::memory_order_release);
+}
+
+int CaptureRecorder::useTimeSlice()
+{
+  // closing is set after recording is cleared, so read it first
+  auto isClosingFile = closing.load(std::memory_order_acquire);
+  if (!isClosingFile && !isRecording())
+  {
+    return idleInterval;
+  }
+
+  // complete chunks only, so that every write is a large one
+  auto numChunks = fifo.getNumReady() / chunkLength;
+  for (int chunk = 0; chunk < numChunks; ++chunk)
+  {
+    writeFromRing(chunkLength);
+  }
+  if (isClosingFile)
+  {
+    closeFile();
+    return idleInterval;
+  }
+
+  // check again a few times per chunk duration
+  auto rate = recordingSampleRate.load(std::memory_order_relaxed);
+  return numChunks > 0 ? 0 : std::max(1, (int)(250. * chunkLength / rate));
+}
+
+void CaptureRecorder::closeFile()
+{
+  // the rest of the ring, then the summaries & header
+  writeFromRing(fifo.getNumReady());
+  writer.reset();
+  captureWriter = nullptr;
+
+  // give back the space reserved past the end of the file
+#if JUCE_LINUX || JUCE_MAC
+  if (reservationDescriptor >= 0)
+  {
+    juce::ignoreUnused(ftruncate(reservationDescriptor, (off_t)recordingFile.getSize()));
+    close(reservationDescriptor);
+  }
+#endif
+  reservationDescriptor = -1;
+
+  // start may reuse everything
+  closing.store(false, std::memory_order_release);
+}
+
+void CaptureRecorder::writeFromRing(int numSamples)
+{
+  if (numSamples <= 0 || writer == nullptr)
+  {
+    return;
+  }
+
+  // keep the reservation ahead of the data
+  auto numBytes = (juce::int64)numSamples * recordingNumChannels * (juce::int64)sizeof(float);
+  auto endBytes = (juce::int64)numWrittenBytes.load(std::memory_order_relaxed) + numBytes;
+  if (endBytes > reservedBytes)
+  {
+    reserveUpTo(endBytes + reservationBytes);
+  }
+
+  // the first of these samples is the oldest in the ring
+  if (captureWriter != nullptr)
+  {
+    auto backlogSeconds = double(fifo.getNumReady()) / recordingSampleRate.load(std::memory_order_relaxed);
+    captureWriter->addTimestamp(juce::Time::currentTimeMillis() - (juce::int64)(backlogSeconds * 1000.),
+                                numDroppedSamples.load(std::memory_order_relaxed));
+  }
+
+  // one write per contiguous span of the ring
+  auto startTicks = juce::Time::getHighResolutionTicks();
+  int start1, size1, start2, size2;
+  fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+  for (auto [start, size] : {std::make_pair(start1, size1), std::make_pair(start2, size2)})
+  {
+    if (size > 0)
+    {
+      for (size_t channel = 0; channel < ring.size(); ++channel)
+      {
+        chunkPointers[channel] = ring[channel].data() + start;
+      }
+      writer->writeFromFloatArrays(chunkPointers.data(), recordingNumChannels, size);
+    }
+  }
+  fifo.finishedRead(size1 + size2);
+  auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+  // count what was written
+  auto numWritten = size1 + size2;
+  numWrittenSamples.fetch_add((juce::uint64)numWritten, std::memory_order_relaxed);
+  numWrittenBytes.fetch_add((juce::uint64)numWritten * (juce::uint64)recordingNumChannels * sizeof(float), std::memory_order_relaxed);
+  writeNanoseconds.fetch_add((juce::uint64)(seconds * 1.0e9), std::memory_order_relaxed);
+}
+
+void CaptureRecorder::reserveUpTo(juce::int64 numBytes)
+{
+  if (numBytes <= reservedBytes)
+  {
+    return;
+  }
+
+#if JUCE_LINUX
+  // blocks past the end of the file, its size is left to the writer
+  if (reservationDescriptor >= 0)
+  {
+    fallocate(reservationDescriptor, FALLOC_FL_KEEP_SIZE, (off_t)reservedBytes, (off_t)(numBytes - reservedBytes));
+  }
+#elif JUCE_MAC
+  // same, relative to the space already allocated
+  if (reservationDescriptor >= 0)
+  {
+    fstore_t store{F_ALLOCATEALL, F_PEOFPOSMODE, 0, (off_t)(numBytes - reservedBytes), 0};
+    fcntl(reservationDescriptor, F_PREALLOCATE, &store);
+  }
+#endif
+  reservedBytes = numBytes;
+}
@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+    CaptureRecorder.h
+    Created: 19 Oct 2026 2:06:41am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "CaptureFileWriter.h"
+
+/**
+ * Copy of every counter of CaptureRecorder, taken at once.
+ */
+struct RecorderSnapshot
+{
+  bool isRecording = false;             /**< Whether a recording is running */
+  bool isClosing = false;               /**< Whether the last file is still being closed */
+  juce::uint64 numWrittenSamples = 0;   /**< Samples per channel written to the file */
+  juce::uint64 numWrittenBytes = 0;     /**< Sample bytes written to the file */
+  double writeSeconds = 0.;             /**< Time spent in file writes */
+  juce::uint64 numOverruns = 0;         /**< Blocks the ring had no room for */
+  juce::uint64 numDroppedSamples = 0;   /**< Samples per channel of those blocks */
+  double maxFill = 0.;                  /**< Highest share of the ring in use */
+  double sampleRate = 44100.;           /**< Sample rate of the recording */
+
+  /**
+   * Get the duration of audio written.
+   *
+   * \return double Recorded seconds.
+   */
+  double getRecordedSeconds() const
+  {
+    return sampleRate > 0. ? double(numWrittenSamples) / sampleRate : 0.;
+  }
+
+  /**
+   * Get the rate at which the file absorbs data while being written to.
+   *
+   * \return double Bytes per second of write time.
+   */
+  double getWriteThroughput() const
+  {
+    return writeSeconds > 0. ? double(numWrittenBytes) / writeSeconds : 0.;
+  }
+};
+
+/**
+ * Streams every captured channel to a 32-bit float WAV file, or to a capture
+ * file with a summary index and timestamps, for hours if needed.
+ *
+ * The audio thread only copies each block into a large lock-free ring,
+ * dropping whole blocks and counting an overrun when it is full. A
+ * juce::TimeSliceThread drains the ring in large chunks into the file, and
+ * reserves disk space well ahead of the write position where the platform
+ * allows so that the file does not fragment as it grows.
+ *
+ * The ring is allocated when a recording starts in a new format and the file
+ * is opened by the message thread, then drained and closed by the writer
+ * thread, so that the audio thread never allocates, locks or touches the file
+ * and stopping never blocks the message thread.
+ */
+class CaptureRecorder : private juce::TimeSliceClient
+{
+public:
+  static constexpr double ringSeconds = 4.;                   /**< Audio the ring holds at least */
+  static constexpr int chunkLength = 16384;                   /**< Samples per channel written at once */
+  static constexpr juce::int64 reservationBytes = 64 << 20;   /**< Disk space reserved ahead of the write position */
+  static constexpr int idleInterval = 100;                    /**< Milliseconds between checks of the writer thread while not recording */
+
+  /**
+   * Construct a new Capture Recorder object
+   *
+   */
+  CaptureRecorder();
+
+  /**
+   * Stops the recording, if any, and the writer thread.
+   *
+   */
+  ~CaptureRecorder() override;
+
+  /**
+   * Sets the format of the next recordings. Stops the running one, whose file
+   * would no longer match. Not to be called concurrently with @ref push, safe
+   * concurrently with @ref start & @ref stop.
+   *
+   * \param newSampleRate Sample rate.
+   * \param newNumChannels Channels recorded.
+   */
+  void prepare(double newSampleRate, int newNumChannels);
+
+  /**
+   * Starts recording into a new file. To be called from the message thread.
+   *
+   * \param file File to create, replaced if it exists. A capture file if it has
+   * the CaptureFileFormat extension, a WAV file otherwise.
+   * \return true if the file could be opened.
+   * \return false otherwise, or if the previous file is still being closed.
+   */
+  bool start(const juce::File &file);
+
+  /**
+   * Stops feeding the ring and returns at once, the writer thread writes what
+   * is left and closes the file.
+   *
+   */
+  void stop();
+
+  /**
+   * Returns whether the writer thread is still closing the last file.
+   *
+   * \return true if closing.
+   * \return false otherwise.
+   */
+  bool isClosing() const;
+
+  /**
+   * Returns whether a recording is running.
+   *
+   * \return true if recording.
+   * \return false otherwise.
+   */
+  bool isRecording() const;
+
+  /**
+   * Copies a block into the ring. Never blocks nor allocates, a block that
+   * does not fit is dropped whole. To be called from the audio thread.
+   *
+   * \param data Block channels.
+   * \param numDataChannels Number of channels in data, missing ones are recorded silent.
+   * \param numSamples Samples per channel.
+   */
+  void push(const float *const *data, int numDataChannels, int numSamples);
+
+  /**
+   * Takes a snapshot of every counter. Safe from any thread.
+   *
+   * \return RecorderSnapshot Current counters.
+   */
+  RecorderSnapshot getSnapshot() const;
+
+  /**
+   * Get a new capture file in the user's documents, named after the current
+   * time.
+   *
+   * \return juce::File File to record into.
+   */
+  static juce::File getDefaultFile();
+
+private:
+  juce::TimeSliceThread writerThread{"Capture Recorder"};   /**< Drains the ring into the file */
+  juce::AbstractFifo fifo{1};                               /**< Ring indices */
+  std::vector<std::vector<float>> ring;                     /**< Ring samples, one buffer per recorded channel */
+  std::vector<const float *> chunkPointers;                 /**< Channels of the span being written */
+  std::unique_ptr<juce::AudioFormatWriter> writer;          /**< Open file, owned by the writer thread while recording or closing */
+  CaptureFileWriter *captureWriter = nullptr;               /**< writer, if it writes a capture file */
+  juce::File recordingFile;                                 /**< File being written */
+  int reservationDescriptor = -1;                           /**< Native handle disk space is reserved through */
+  juce::int64 reservedBytes = 0;                            /**< Bytes reserved from the start of the file */
+
+  juce::CriticalSection controlLock;                         /**< Serialises prepare, start & stop */
+  double sampleRate = 44100.;                               /**< Sample rate of the next recordings, guarded by controlLock */
+  int numChannels = 1;                                      /**< Channels of the next recordings, guarded by controlLock */
+  int recordingNumChannels = 1;                             /**< Channels of the recording */
+  std::atomic<bool> recording{false};                       /**< Whether the audio thread feeds the ring */
+  std::atomic<bool> closing{false};                         /**< Whether the writer thread has a file to close */
+
+  std::atomic<juce::uint64> numWrittenSamples{0};           /**< Samples per channel written */
+  std::atomic<juce::uint64> numWrittenBytes{0};             /**< Sample bytes written */
+  std::atomic<juce::uint64> writeNanoseconds{0};            /**< Time spent in file writes */
+  std::atomic<juce::uint64> numOverruns{0};                 /**< Blocks dropped */
+  std::atomic<juce::uint64> numDroppedSamples{0};           /**< Samples per channel dropped */
+  std::atomic<double> maxFill{0.};                          /**< Highest share of the ring in use */
+  std::atomic<double> recordingSampleRate{44100.};          /**< Sample rate of the recording */
+
+  /**
+   * Stops feeding the ring and hands the file over to the writer thread to
+   * close. controlLock must be held.
+   *
+   */
+  void requestClose();
+
+  /**
+   * Writes every complete chunk in the ring, or everything and closes the
+   * file after @ref stop. Called by the writer thread.
+   *
+   * \return int Milliseconds until the next call.
+   */
+  int useTimeSlice() override;
+
+  /**
+   * Writes what is left in the ring, closes the file and gives back the
+   * reserved space. Called by the writer thread, or on destruction once it is
+   * idle.
+   *
+   */
+  void closeFile();
+
+  /**
+   * Writes the oldest samples of the ring to the file and frees them.
+   *
+   * \param numSamples Samples per channel to write, at most the ready ones.
+   */
+  void writeFromRing(int numSamples);
+
+  /**
+   * Reserves disk space for the file up to a byte offset, without changing
+   * its size. Does nothing where the platform has no such call.
+   *
+   * \param numBytes Bytes from the start of the file to reserve.
+   */
+  void reserveUpTo(juce::int64 numBytes);
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CaptureRecorder)
+};
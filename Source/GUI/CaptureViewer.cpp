@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    CaptureViewer.cpp
+    Created: 19 Oct 2026 3:48:26am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "CaptureViewer.h"
+#include <algorithm>
+#include <cmath>
+
+CaptureViewer::CaptureViewer(const juce::File &file)
+    : reader(file), fileName(file.getFileName())
+{
+  // interrupted recordings have no timestamps, say so in the ruler
+  if (reader.isRecovered())
+  {
+    fileName += " (recovered)";
+  }
+
+  addAndMakeVisible(scrollBar);
+  scrollBar.addListener(this);
+
+  // the whole capture to start with
+  scrollBar.setRangeLimits(0., (double)std::max<juce::int64>(1, reader.getNumFrames()));
+  setView(0., (double)reader.getNumFrames());
+  setSize(900, 480);
+}
+
+CaptureViewer::~CaptureViewer()
+{
+  scrollBar.removeListener(this);
+}
+
+void CaptureViewer::paint(juce::Graphics &g)
+{
+  g.fillAll(juce::Colours::black);
+  g.setColour(juce::Colours::ghostwhite);
+  g.setFont(12.f);
+  if (!reader.isValid())
+  {
+    g.drawText("Not a capture file", getLocalBounds(), juce::Justification::centred, true);
+    return;
+  }
+
+  // ruler: position & capture time of both edges, frames lost in between
+  auto describe = [this](juce::int64 frame)
+  {
+    auto text = juce::String(double(frame) / reader.getSampleRate(), 3) + " s";
+    auto time = reader.getTimeOfFrame(frame);
+    return time.toMilliseconds() == 0 ? text : text + ", " + time.formatted("%Y-%m-%d %H:%M:%S");
+  };
+  auto firstFrame = (juce::int64)viewStart;
+  auto lastFrame = (juce::int64)(viewStart + viewLength);
+  auto numLost = reader.getNumDroppedFramesBefore(lastFrame) - reader.getNumDroppedFramesBefore(firstFrame);
+  auto ruler = getLocalBounds().removeFromTop(rulerHeight).reduced(4, 0);
+  g.drawText(describe(firstFrame), ruler, juce::Justification::centredLeft, true);
+  g.drawText(numLost > 0 ? fileName + ", " + juce::String((juce::int64)numLost) + " frames lost" : fileName, ruler, juce::Justification::centred, true);
+  g.drawText(describe(lastFrame), ruler, juce::Justification::right, true);
+
+  // one lane per channel, one min to max line per column
+  auto area = getLanesArea();
+  auto numChannels = reader.getNumChannels();
+  auto laneHeight = float(area.getHeight()) / float(numChannels);
+  minColumn.resize((size_t)area.getWidth());
+  maxColumn.resize((size_t)area.getWidth());
+  for (int channel = 0; channel < numChannels; ++channel)
+  {
+    reader.render(channel, viewStart, viewLength, area.getWidth(), minColumn.data(), maxColumn.data());
+    auto centre = float(area.getY()) + laneHeight * (float(channel) + 0.5f);
+    auto halfHeight = laneHeight / 2.f;
+    g.setColour(CHANNELCOLOUR(channel));
+    for (int x = 0; x < area.getWidth(); ++x)
+    {
+      auto top = centre - juce::jlimit(-1.f, 1.f, maxColumn[(size_t)x]) * halfHeight;
+      auto bottom = centre - juce::jlimit(-1.f, 1.f, minColumn[(size_t)x]) * halfHeight;
+      g.drawVerticalLine(area.getX() + x, top, std::max(bottom, top + 1.f));
+    }
+
+    // lane axis
+    g.setColour(juce::Colours::ghostwhite.withAlpha(0.2f));
+    g.drawHorizontalLine((int)centre, float(area.getX()), float(area.getRight()));
+  }
+}
+
+void CaptureViewer::resized()
+{
+  scrollBar.setBounds(getLocalBounds().removeFromBottom(scrollBarHeight));
+}
+
+void CaptureViewer::mouseDown(const juce::MouseEvent &event)
+{
+  dragStartView = viewStart;
+}
+
+void CaptureViewer::mouseDrag(const juce::MouseEvent &event)
+{
+  // the capture follows the pointer
+  auto width = std::max(1, getLanesArea().getWidth());
+  setView(dragStartView - double(event.getDistanceFromDragStartX()) / width * viewLength, viewLength);
+}
+
+void CaptureViewer::mouseDoubleClick(const juce::MouseEvent &event)
+{
+  setView(0., (double)reader.getNumFrames());
+}
+
+void CaptureViewer::mouseWheelMove(const juce::MouseEvent &event, const juce::MouseWheelDetails &wheel)
+{
+  // zoom around the frame under the pointer
+  auto area = getLanesArea();
+  auto proportion = juce::jlimit(0., 1., double(event.position.x - float(area.getX())) / std::max(1, area.getWidth()));
+  auto anchor = viewStart + proportion * viewLength;
+  auto length = viewLength * std::pow(2., -4. * wheel.deltaY);
+  setView(anchor - proportion * length, length);
+}
+
+void CaptureViewer::setView(double start, double length)
+{
+  auto numFrames = (double)reader.getNumFrames();
+  viewLength = juce::jlimit(std::min(minVisibleFrames, std::max(1., numFrames)), std::max(1., numFrames), length);
+  viewStart = juce::jlimit(0., std::max(0., numFrames - viewLength), start);
+  scrollBar.setCurrentRange(viewStart, viewLength, juce::dontSendNotification);
+  repaint();
+}
+
+juce::Rectangle<int> CaptureViewer::getLanesArea() const
+{
+  return getLocalBounds().withTrimmedTop(rulerHeight).withTrimmedBottom(scrollBarHeight);
+}
+
+void CaptureViewer::scrollBarMoved(juce::ScrollBar *scrollBarThatHasMoved, double newRangeStart)
+{
+  setView(newRangeStart, viewLength);
+}
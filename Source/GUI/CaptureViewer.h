@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    CaptureViewer.h
+    Created: 19 Oct 2026 3:48:26am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include "../CaptureFileReader.h"
+#include "ColorPalette.h"
+
+/**
+ * Browser of a recorded capture file, one lane per channel.
+ *
+ * Each paint renders the visible span through a @ref CaptureFileReader, so it
+ * reads a bounded amount of the file per pixel column: jumping anywhere in a
+ * capture of any length costs the same. The mouse wheel zooms around the
+ * pointer, dragging or the scroll bar pans, a double click shows everything.
+ */
+class CaptureViewer : public juce::Component, private juce::ScrollBar::Listener
+{
+public:
+  /**
+   * Construct a new Capture Viewer object
+   *
+   * \param file Capture file to browse.
+   */
+  explicit CaptureViewer(const juce::File &file);
+
+  ~CaptureViewer() override;
+
+  void paint(juce::Graphics &) override;
+  void resized() override;
+
+  void mouseDown(const juce::MouseEvent &event) override;
+  void mouseDrag(const juce::MouseEvent &event) override;
+  void mouseDoubleClick(const juce::MouseEvent &event) override;
+  void mouseWheelMove(const juce::MouseEvent &event, const juce::MouseWheelDetails &wheel) override;
+
+private:
+  static constexpr int scrollBarHeight = 14;          /**< Height of the scroll bar */
+  static constexpr int rulerHeight = 18;              /**< Height of the time ruler */
+  static constexpr double minVisibleFrames = 16.;     /**< Shortest span shown */
+
+  CaptureFileReader reader;                           /**< Mapped capture file */
+  juce::String fileName;                              /**< Name shown in the ruler */
+  juce::ScrollBar scrollBar{false};                   /**< Position in the capture */
+  double viewStart = 0.;                              /**< First visible frame */
+  double viewLength = 1.;                             /**< Visible frames */
+  double dragStartView = 0.;                          /**< viewStart when the drag started */
+  std::vector<float> minColumn;                       /**< Minimum of each column of a lane */
+  std::vector<float> maxColumn;                       /**< Maximum of each column of a lane */
+
+  /**
+   * Shows a span of the capture, clamped to it.
+   *
+   * \param start First frame.
+   * \param length Number of frames.
+   */
+  void setView(double start, double length);
+
+  /**
+   * Get the area the lanes are drawn in.
+   *
+   * \return juce::Rectangle<int> Lanes area.
+   */
+  juce::Rectangle<int> getLanesArea() const;
+
+  void scrollBarMoved(juce::ScrollBar *scrollBarThatHasMoved, double newRangeStart) override;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CaptureViewer)
+};
@@ -31,3 +31,23 @@ static juce::Colour GUITOGGLERCOLOUR() { return juce::Colours::ghostwhite.withAl
  * \return juce::Colour Waveform colour.
  */
 static juce::Colour WAVEFORMCOLOUR() { return juce::Colours::beige; };
+
+
+/**
+ * Colour of a channel's trace. The first channel uses the waveform colour.
+ *
+ * \param channel Channel index.
+ * \return juce::Colour Channel colour.
+ */
+static juce::Colour CHANNELCOLOUR(int channel)
+{
+  static const juce::Colour colours[] = {WAVEFORMCOLOUR(),
+                                         juce::Colours::lightskyblue,
+                                         juce::Colours::salmon,
+                                         juce::Colours::palegreen,
+                                         juce::Colours::plum,
+                                         juce::Colours::khaki,
+                                         juce::Colours::aquamarine,
+                                         juce::Colours::lightpink};
+  return colours[channel % (int)(sizeof(colours) / sizeof(colours[0]))];
+};
\ No newline at end of file
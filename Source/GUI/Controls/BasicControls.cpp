@@ -18,10 +18,20 @@ BasicControls::BasicControls()
   addAndMakeVisible(drawGrid);
   addAndMakeVisible(bufferLength);
   addAndMakeVisible(muteOutput);
+  addAndMakeVisible(persistence);
+  addAndMakeVisible(displayMode);
+  addAndMakeVisible(record);
+  addAndMakeVisible(openCapture);
 
   // set texts
   drawGrid.setButtonText("Grid");
   muteOutput.setButtonText("Mute");
+  persistence.setButtonText("Persistence");
+  record.setButtonText("Rec");
+  openCapture.setButtonText("Open");
+
+  // display modes, in the order of the parameter's, before the attachment is made
+  displayMode.addItemList({"Scope", "Spectrum", "Spectrogram", "XY", "Goniometer"}, 1);
 
   // set styles
   bufferLength.setSliderStyle(juce::Slider::SliderStyle::LinearHorizontal);
@@ -43,12 +53,24 @@ void BasicControls::resized()
    *
    */
 
-  drawGrid.setSize(getWidth() / 5., getHeight() * 3. / 4.);
+  drawGrid.setSize(getWidth() / 10., getHeight() * 3. / 4.);
   drawGrid.setTopLeftPosition(10, getHeight() / 8.);
 
-  muteOutput.setSize(getWidth() / 5., getHeight() * 3. / 4.);
-  muteOutput.setTopLeftPosition(10 + getWidth() / 5, getHeight() / 8.);
+  muteOutput.setSize(getWidth() / 10., getHeight() * 3. / 4.);
+  muteOutput.setTopLeftPosition(10 + getWidth() / 10, getHeight() / 8.);
+
+  displayMode.setSize(getWidth() / 5. - 20, getHeight() / 2.);
+  displayMode.setTopLeftPosition(10 + getWidth() / 5, getHeight() / 4.);
+
+  persistence.setSize(getWidth() / 10., getHeight() * 3. / 4.);
+  persistence.setTopLeftPosition(10 + getWidth() * 2. / 5., getHeight() / 8.);
+
+  record.setSize(getWidth() / 20. - 10, getHeight() * 3. / 4.);
+  record.setTopLeftPosition(10 + getWidth() / 2., getHeight() / 8.);
 
   bufferLength.setSize(getWidth() * 2 / 5, getHeight() * 3. / 4.);
   bufferLength.setTopLeftPosition(getWidth() * 11. / 20., getHeight() / 8.);
+
+  openCapture.setSize(getWidth() / 20. - 10, getHeight() / 2.);
+  openCapture.setTopLeftPosition(getWidth() * 19. / 20., getHeight() / 4.);
 }
@@ -45,12 +45,37 @@ public:
    */
   juce::ToggleButton muteOutput;
 
+  /**
+   * Controls whether to accumulate traces like an analog phosphor.
+   *
+   */
+  juce::ToggleButton persistence;
+
+  /**
+   * Starts & stops recording the captured channels to disk. Not attached to a
+   * parameter, the host must not automate file writes.
+   *
+   */
+  juce::ToggleButton record;
+
+  /**
+   * Opens a recorded capture file in a viewer window.
+   *
+   */
+  juce::TextButton openCapture;
+
   /**
    * Controls length displayed.
    *
    */
   juce::Slider bufferLength;
 
+  /**
+   * Selects the displayed view.
+   *
+   */
+  juce::ComboBox displayMode;
+
   /**
    * bufferLength attachment.
    *
@@ -69,6 +94,18 @@ public:
    */
   std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> muteOutputAttachment;
 
+  /**
+   * persistence attachment.
+   *
+   */
+  std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> persistenceAttachment;
+
+  /**
+   * displayMode attachment.
+   *
+   */
+  std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> displayModeAttachment;
+
 private:
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BasicControls)
 };
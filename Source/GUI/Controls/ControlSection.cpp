@@ -100,6 +100,60 @@ void ControlSection::setAttachment(juce::String attachmentName, juce::AudioProce
             new juce::AudioProcessorValueTreeState::ButtonAttachment(processorTreeState, attachmentName, basicControls.muteOutput));
         break;
     }
+    case (ControlSection::Attachments::TriggerPosition):
+    {
+        proControls.triggerPositionAttachment.reset(
+            new juce::AudioProcessorValueTreeState::SliderAttachment(processorTreeState, attachmentName, proControls.triggerPosition));
+        break;
+    }
+    case (ControlSection::Attachments::HoldoffTime):
+    {
+        proControls.holdoffTimeAttachment.reset(
+            new juce::AudioProcessorValueTreeState::SliderAttachment(processorTreeState, attachmentName, proControls.holdoffTime));
+        break;
+    }
+    case (ControlSection::Attachments::BackgroundRender):
+    {
+        proControls.backgroundRenderAttachment.reset(
+            new juce::AudioProcessorValueTreeState::ButtonAttachment(processorTreeState, attachmentName, proControls.backgroundRenderButton));
+        break;
+    }
+    case (ControlSection::Attachments::Persistence):
+    {
+        basicControls.persistenceAttachment.reset(
+            new juce::AudioProcessorValueTreeState::ButtonAttachment(processorTreeState, attachmentName, basicControls.persistence));
+        break;
+    }
+    case (ControlSection::Attachments::Resampler):
+    {
+        proControls.resamplerAttachment.reset(
+            new juce::AudioProcessorValueTreeState::ComboBoxAttachment(processorTreeState, attachmentName, proControls.resampler));
+        break;
+    }
+    case (ControlSection::Attachments::DisplayMode):
+    {
+        basicControls.displayModeAttachment.reset(
+            new juce::AudioProcessorValueTreeState::ComboBoxAttachment(processorTreeState, attachmentName, basicControls.displayMode));
+        break;
+    }
+    case (ControlSection::Attachments::FftSize):
+    {
+        proControls.fftSizeAttachment.reset(
+            new juce::AudioProcessorValueTreeState::ComboBoxAttachment(processorTreeState, attachmentName, proControls.fftSize));
+        break;
+    }
+    case (ControlSection::Attachments::FftWindow):
+    {
+        proControls.fftWindowAttachment.reset(
+            new juce::AudioProcessorValueTreeState::ComboBoxAttachment(processorTreeState, attachmentName, proControls.fftWindow));
+        break;
+    }
+    case (ControlSection::Attachments::SpectrumAveraging):
+    {
+        proControls.spectrumAveragingAttachment.reset(
+            new juce::AudioProcessorValueTreeState::ComboBoxAttachment(processorTreeState, attachmentName, proControls.spectrumAveraging));
+        break;
+    }
     default:
     {
         break;
@@ -129,6 +183,22 @@ void ControlSection::resetNumHorizontalSections()
     }
 }
 
+void ControlSection::setRecordCallback(std::function<void(bool)> onRecordToggled)
+{
+    basicControls.record.onClick = [this, onRecordToggled]()
+    { onRecordToggled(basicControls.record.getToggleState()); };
+}
+
+void ControlSection::setRecordState(bool isRecording)
+{
+    basicControls.record.setToggleState(isRecording, juce::dontSendNotification);
+}
+
+void ControlSection::setOpenCaptureCallback(std::function<void()> onOpenCapture)
+{
+    basicControls.openCapture.onClick = onOpenCapture;
+}
+
 void ControlSection::resetButtonText()
 {
     // check state and set text
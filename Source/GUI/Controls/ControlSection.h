@@ -65,6 +65,27 @@ public:
    */
   void resetButtonText();
 
+  /**
+   * Set what the record button does.
+   *
+   * \param onRecordToggled Called with the new button state when clicked.
+   */
+  void setRecordCallback(std::function<void(bool)> onRecordToggled);
+
+  /**
+   * Show whether a recording is running, without calling the record callback.
+   *
+   * \param isRecording Whether a recording is running.
+   */
+  void setRecordState(bool isRecording);
+
+  /**
+   * Set what the open capture button does.
+   *
+   * \param onOpenCapture Called when clicked.
+   */
+  void setOpenCaptureCallback(std::function<void()> onOpenCapture);
+
   void paint(juce::Graphics &) override;
   void resized() override;
 
@@ -83,6 +104,15 @@ private:
     IsAutoTriggered,
     DecayTime,
     MuteOutput,
+    TriggerPosition,
+    HoldoffTime,
+    BackgroundRender,
+    Persistence,
+    Resampler,
+    DisplayMode,
+    FftSize,
+    FftWindow,
+    SpectrumAveraging,
     Default
   };
 
@@ -99,6 +129,15 @@ private:
       {"autoTriggered", ControlSection::Attachments::IsAutoTriggered},
       {"decayTime", ControlSection::Attachments::DecayTime},
       {"muteOutput", ControlSection::Attachments::MuteOutput},
+      {"triggerPosition", ControlSection::Attachments::TriggerPosition},
+      {"holdoffTime", ControlSection::Attachments::HoldoffTime},
+      {"backgroundRender", ControlSection::Attachments::BackgroundRender},
+      {"persistence", ControlSection::Attachments::Persistence},
+      {"resampler", ControlSection::Attachments::Resampler},
+      {"displayMode", ControlSection::Attachments::DisplayMode},
+      {"fftSize", ControlSection::Attachments::FftSize},
+      {"fftWindow", ControlSection::Attachments::FftWindow},
+      {"spectrumAveraging", ControlSection::Attachments::SpectrumAveraging},
 
   };
 
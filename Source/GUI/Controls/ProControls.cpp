@@ -19,6 +19,13 @@ ProControls::ProControls()
     addAndMakeVisible(slopeButton);
     addAndMakeVisible(triggerLevel);
     addAndMakeVisible(refreshTime);
+    addAndMakeVisible(triggerPosition);
+    addAndMakeVisible(holdoffTime);
+    addAndMakeVisible(backgroundRenderButton);
+    addAndMakeVisible(resampler);
+    addAndMakeVisible(fftSize);
+    addAndMakeVisible(fftWindow);
+    addAndMakeVisible(spectrumAveraging);
 
     // add autoTrigger
     addChildComponent(autoTriggerButton);
@@ -27,6 +34,13 @@ ProControls::ProControls()
     triggerButton.setButtonText("Trigger");
     autoTriggerButton.setButtonText("Auto");
     slopeButton.setButtonText("Slope");
+    backgroundRenderButton.setButtonText("Threaded");
+
+    // resampler choices, in the order of the parameter's, before the attachment is made
+    resampler.addItemList({"Linear", "Cubic", "Sinc"}, 1);
+    fftSize.addItemList({"1024", "2048", "4096", "8192", "16384", "32768", "65536"}, 1);
+    fftWindow.addItemList({"Hann", "Blackman-Harris", "Flat Top"}, 1);
+    spectrumAveraging.addItemList({"Off", "Fast", "Medium", "Slow"}, 1);
 
     // show autoTrigger only if triggered
     triggerButton.onClick = [this](){
@@ -39,6 +53,10 @@ ProControls::ProControls()
     triggerLevel.setTextBoxStyle(juce::Slider::NoTextBox, true, 0, 0);
     refreshTime.setSliderStyle(juce::Slider::SliderStyle::RotaryHorizontalVerticalDrag);
     refreshTime.setTextBoxStyle(juce::Slider::NoTextBox, true, 0, 0);
+    triggerPosition.setSliderStyle(juce::Slider::SliderStyle::RotaryHorizontalVerticalDrag);
+    triggerPosition.setTextBoxStyle(juce::Slider::NoTextBox, true, 0, 0);
+    holdoffTime.setSliderStyle(juce::Slider::SliderStyle::RotaryHorizontalVerticalDrag);
+    holdoffTime.setTextBoxStyle(juce::Slider::NoTextBox, true, 0, 0);
 
 }
 
@@ -63,13 +81,34 @@ void ProControls::resized()
   autoTriggerButton.setSize(getWidth() / 10., getHeight() * 3. / 4.);
   autoTriggerButton.setTopLeftPosition(10 + getWidth() / 10, getHeight() / 8.);
 
-  slopeButton.setSize(getWidth() / 5., getHeight() * 3. / 4.);
+  backgroundRenderButton.setSize(getWidth() / 10. - 10, getHeight() * 3. / 4.);
+  backgroundRenderButton.setTopLeftPosition(10 + getWidth() / 5., getHeight() / 8.);
+
+  resampler.setSize(getWidth() / 10. - 10, getHeight() / 4.);
+  resampler.setTopLeftPosition(getWidth() * 3. / 10., getHeight() * 3. / 8.);
+
+  slopeButton.setSize(getWidth() / 10., getHeight() * 3. / 4.);
   slopeButton.setTopLeftPosition(10 + getWidth() * 2. / 5., getHeight() / 8.);
 
-  triggerLevel.setSize(getWidth() / 8, getHeight() * 3. / 4.);
+  fftSize.setSize(getWidth() / 10. - 10, getHeight() / 4.);
+  fftSize.setTopLeftPosition(getWidth() / 2., getHeight() / 8.);
+
+  fftWindow.setSize(getWidth() / 10. - 10, getHeight() / 4.);
+  fftWindow.setTopLeftPosition(getWidth() / 2., getHeight() * 3. / 8.);
+
+  spectrumAveraging.setSize(getWidth() / 10. - 10, getHeight() / 4.);
+  spectrumAveraging.setTopLeftPosition(getWidth() / 2., getHeight() * 5. / 8.);
+
+  triggerLevel.setSize(getWidth() / 10, getHeight() * 3. / 4.);
   triggerLevel.setTopLeftPosition(getWidth() * 3. / 5., getHeight() / 8.);
 
-  refreshTime.setSize(getWidth() / 8, getHeight() * 3. / 4.);
+  refreshTime.setSize(getWidth() / 10, getHeight() * 3. / 4.);
   refreshTime.setTopLeftPosition(getWidth() * 7. / 10., getHeight() / 8.);
 
+  triggerPosition.setSize(getWidth() / 10, getHeight() * 3. / 4.);
+  triggerPosition.setTopLeftPosition(getWidth() * 8. / 10., getHeight() / 8.);
+
+  holdoffTime.setSize(getWidth() / 10, getHeight() * 3. / 4.);
+  holdoffTime.setTopLeftPosition(getWidth() * 9. / 10., getHeight() / 8.);
+
 }
@@ -63,6 +63,48 @@ public:
    */
   juce::Slider refreshTime;
 
+  /**
+   * Controls whether traces are rendered by a background thread.
+   *
+   */
+  juce::ToggleButton backgroundRenderButton;
+
+  /**
+   * Slider determining the fraction of the view shown before the trigger.
+   *
+   */
+  juce::Slider triggerPosition;
+
+  /**
+   * Slider determining the minimum time between two triggers.
+   *
+   */
+  juce::Slider holdoffTime;
+
+  /**
+   * Selects how the waveform is reconstructed when zoomed in past the samples.
+   *
+   */
+  juce::ComboBox resampler;
+
+  /**
+   * Selects the FFT size of the spectrum.
+   *
+   */
+  juce::ComboBox fftSize;
+
+  /**
+   * Selects the window applied to each spectrum frame.
+   *
+   */
+  juce::ComboBox fftWindow;
+
+  /**
+   * Selects how long spectra are averaged.
+   *
+   */
+  juce::ComboBox spectrumAveraging;
+
   /**
    * @ref triggerLevel attachment.
    *
@@ -75,6 +117,48 @@ public:
    */
   std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> refreshTimeAttachment;
 
+  /**
+   * @ref backgroundRenderButton attachment.
+   *
+   */
+  std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> backgroundRenderAttachment;
+
+  /**
+   * @ref triggerPosition attachment.
+   *
+   */
+  std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> triggerPositionAttachment;
+
+  /**
+   * @ref holdoffTime attachment.
+   *
+   */
+  std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> holdoffTimeAttachment;
+
+  /**
+   * @ref resampler attachment.
+   *
+   */
+  std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> resamplerAttachment;
+
+  /**
+   * @ref fftSize attachment.
+   *
+   */
+  std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> fftSizeAttachment;
+
+  /**
+   * @ref fftWindow attachment.
+   *
+   */
+  std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> fftWindowAttachment;
+
+  /**
+   * @ref spectrumAveraging attachment.
+   *
+   */
+  std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> spectrumAveragingAttachment;
+
   /**
    * @ref triggerButton attachment.
    *
@@ -12,19 +12,21 @@
 
 GuiTransformer::GuiTransformer(
     OscilloscopeAudioProcessor &aProcessor,
+    juce::Component &componentToAnimate,
     float transitionDuration,
-    std::function<void()> expandLambdaFunction,
-    std::function<void()> contractLambdaFunction,
+    std::function<void(float)> expandLambdaFunction,
+    std::function<void(float)> contractLambdaFunction,
     std::function<void()> expandStartedLambdaFunction,
     std::function<void()> contractStartedLambdaFunction,
     std::function<void()> expandEndedLambdaFunction,
     std::function<void()> contractEndedLambdaFunction)
+    : component(componentToAnimate)
 {
   // save variables
   this->transitionDuration = transitionDuration;
-  isProfessional = aProcessor.getTreeState()->getParameterAsValue("isProfessional").getValue();
+  isProfessional = aProcessor.getParameterCache().getSnapshot().isProfessional;
   aProcessor.getTreeState()->addParameterListener("isProfessional", this);
-  framesRemaining = float(EDITOR_INITIAL_RATE()) * transitionDuration;
+  secondsRemaining = transitionDuration;
 
   // save lambdas
   expandLambda = expandLambdaFunction;
@@ -37,20 +39,33 @@ GuiTransformer::GuiTransformer(
 
 GuiTransformer::~GuiTransformer()
 {
+  cancelPendingUpdate();
 }
 
-void GuiTransformer::timerCallback()
+void GuiTransformer::onVBlank()
 {
+  // the attachment stays alive between transitions
+  if (!isAnimating)
+  {
+    return;
+  }
+
+  // advance by the time elapsed since the previous step
+  auto now = juce::Time::getMillisecondCounterHiRes();
+  auto elapsed = std::min(float(now - lastStepTime) / 1000.f, secondsRemaining);
+  lastStepTime = now;
+
   // if animation not ended expand/contract
-  if (framesRemaining-- > 0)
+  if (secondsRemaining > 0.f)
   {
+    secondsRemaining -= elapsed;
     if (isProfessional)
     {
-      expandLambda();
+      expandLambda(elapsed / transitionDuration);
     }
     else
     {
-      contractLambda();
+      contractLambda(elapsed / transitionDuration);
     }
   }
   // else trigger end lambda and stop
@@ -64,15 +79,22 @@ void GuiTransformer::timerCallback()
     {
       contractEndedLambda();
     }
-    framesRemaining = float(EDITOR_INITIAL_RATE()) * transitionDuration;
-    stopTimer();
+    secondsRemaining = transitionDuration;
+    isAnimating = false;
   }
 }
 
 void GuiTransformer::parameterChanged(const juce::String &parameterID, float newValue)
+{
+  // may be the audio thread under automation, start on the message thread
+  nextIsProfessional.store(bool(newValue));
+  triggerAsyncUpdate();
+}
+
+void GuiTransformer::handleAsyncUpdate()
 {
   // save new value
-  isProfessional = bool(newValue);
+  isProfessional = nextIsProfessional.load();
 
   // trigger appropriate start lambda
   if (isProfessional)
@@ -86,6 +108,12 @@ void GuiTransformer::parameterChanged(const juce::String &parameterID, float new
     contractStartedLambda();
   }
 
-  // start timer
-  startTimerHz(EDITOR_INITIAL_RATE());
+  // start animating on the next vertical blank
+  lastStepTime = juce::Time::getMillisecondCounterHiRes();
+  isAnimating = true;
+  if (vBlankAttachment == nullptr)
+  {
+    vBlankAttachment.reset(new juce::VBlankAttachment(&component, [this]()
+                                                      { onVBlank(); }));
+  }
 }
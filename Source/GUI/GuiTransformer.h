@@ -12,23 +12,29 @@
 #pragma once
 #include "../InitVariables.h"
 #include <JuceHeader.h>
+#include <atomic>
 #include "../PluginProcessor.h"
 
 /**
  * Class to handle GUI transition between Pro and
  * raw modalities.
  *
+ * The transition advances on the vertical blank of the animated component,
+ * by the time actually elapsed, so that it lasts the same at any frame rate.
+ *
  */
-class GuiTransformer : public juce::Timer, private juce::AudioProcessorValueTreeState::Listener
+class GuiTransformer : private juce::AudioProcessorValueTreeState::Listener,
+                       private juce::AsyncUpdater
 {
 public:
    /**
     * Construct a new Gui Transformer object
     *
     * \param aProcessor PluginProcessor reference.
+    * \param componentToAnimate Component whose display paces the transition.
     * \param transitionDuration Duration of the transition in seconds.
-    * \param expandLambdaFunction Lambda function to call when expanding ControlSection.
-    * \param contractLambdaFunction Lambda function to call when contracting ControlSection.
+    * \param expandLambdaFunction Lambda function to call when expanding ControlSection, with the fraction of the transition elapsed since the previous call.
+    * \param contractLambdaFunction Lambda function to call when contracting ControlSection, with the fraction of the transition elapsed since the previous call.
     * \param expandStartedLambdaFunction Lambda function to call when ControlSection expansion starts.
     * \param contractStartedLambdaFunction Lambda function to call when ControlSection contraction starts.
     * \param expandEndedLambdaFunction Lambda function to call when ControlSection expansion ends.
@@ -36,9 +42,10 @@ public:
     */
    GuiTransformer(
        OscilloscopeAudioProcessor &aProcessor,
+       juce::Component &componentToAnimate,
        float transitionDuration,
-       std::function<void()> expandLambdaFunction,
-       std::function<void()> contractLambdaFunction,
+       std::function<void(float)> expandLambdaFunction,
+       std::function<void(float)> contractLambdaFunction,
        std::function<void()> expandStartedLambdaFunction,
        std::function<void()> contractStartedLambdaFunction,
        std::function<void()> expandEndedLambdaFunction,
@@ -47,10 +54,41 @@ public:
 
 private:
    /**
-    * Frames of the transition remaining.
+    * Seconds of the transition remaining.
+    *
+    */
+   float secondsRemaining;
+
+   /**
+    * Time of the previous animation step, in milliseconds.
+    *
+    */
+   double lastStepTime = 0.;
+
+   /**
+    * Component whose display paces the transition.
+    *
+    */
+   juce::Component &component;
+
+   /**
+    * Vertical blank callbacks, attached on the first transition and kept,
+    * since an attachment must not be destroyed from its own callback.
     *
     */
-   int framesRemaining;
+   std::unique_ptr<juce::VBlankAttachment> vBlankAttachment;
+
+   /**
+    * Whether a transition runs, vertical blanks are ignored otherwise.
+    *
+    */
+   bool isAnimating = false;
+
+   /**
+    * Value of the parameter, handed over from the listener's thread.
+    *
+    */
+   std::atomic<bool> nextIsProfessional{false};
 
    /**
     * Duration of the transition in seconds;
@@ -59,11 +97,11 @@ private:
    float transitionDuration;
 
    /**
-    * Timer callback. Will be called @ frame rate for
-    * @param tframesRemaining frames.
+    * Vertical blank callback. Advances the transition by the elapsed time
+    * until @ref secondsRemaining runs out.
     *
     */
-   void timerCallback() override;
+   void onVBlank();
 
    /**
     * Updates the buffer length when the parameter is modified.
@@ -73,16 +111,22 @@ private:
     */
    void parameterChanged(const juce::String &parameterID, float newValue) override;
 
+   /**
+    * Starts the transition on the message thread.
+    *
+    */
+   void handleAsyncUpdate() override;
+
    /**
     * Callback triggered when controlSection is expanding.
     *
     */
-   std::function<void()> expandLambda;
+   std::function<void(float)> expandLambda;
    /**
     * Callback triggered when controlSection is contracting.
     *
     */
-   std::function<void()> contractLambda;
+   std::function<void(float)> contractLambda;
    /**
     * Callback triggered when controlSection has started expanding.
     *
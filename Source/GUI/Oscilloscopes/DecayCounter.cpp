@@ -10,12 +10,11 @@
 
 #include "DecayCounter.h"
 
-DecayCounter::DecayCounter(int framesPerSecond, float decaySeconds)
+DecayCounter::DecayCounter(float decaySeconds)
 {
   // save parameters.
-  this->framesPerSecond = framesPerSecond;
   this->decaySeconds = decaySeconds;
-  this->decayTime = framesPerSecond * decaySeconds;
+  this->decayTime = decaySeconds;
   this->maxDecayTime = OSCILLOSCOPE_MAX_DECAY_TIME();
 }
 
@@ -23,10 +22,11 @@ DecayCounter::~DecayCounter()
 {
 }
 
-bool DecayCounter::refreshNeeded()
+bool DecayCounter::refreshNeeded(double elapsedSeconds)
 {
   // decrement decayTime and return whether it hit 0
-  if (decayTime-- > 0)
+  decayTime -= elapsedSeconds;
+  if (decayTime > 0)
   {
     return false;
   }
@@ -40,7 +40,7 @@ bool DecayCounter::refreshNeeded()
 void DecayCounter::resetDecayTime()
 {
   // reset to initial value.
-  decayTime = framesPerSecond * decaySeconds;
+  decayTime = decaySeconds;
 }
 
 void DecayCounter::parameterChanged(const juce::String &parameterID, float newValue)
@@ -20,11 +20,11 @@ class DecayCounter : public juce::AudioProcessorValueTreeState::Listener
 {
 private:
   /**
-   * Decay time. Represents the number of frames to wait before
+   * Decay time. Represents the number of seconds to wait before
    * refreshing the wave plot.
    *
    */
-  int decayTime;
+  double decayTime;
 
   /**
    * Maximum decay time in seconds.
@@ -32,12 +32,6 @@ private:
    */
   int maxDecayTime;
 
-  /**
-   * Editor's frames per second.
-   *
-   */
-  int framesPerSecond;
-
   /**
    * Decay time in seconds.
    *
@@ -48,10 +42,9 @@ public:
   /**
    * Construct a new Decay Counter object
    *
-   * \param framesPerSecond PluginEditor refresh rate.
    * \param decaySeconds Decay time in seconds.
    */
-  DecayCounter(int framesPerSecond, float decaySeconds);
+  DecayCounter(float decaySeconds);
 
   /**
    * Destroy the Decay Counter object
@@ -60,16 +53,17 @@ public:
   ~DecayCounter();
 
   /**
-   * Decrements decay time and returns whether if it is time to
-   * refresh the wave plot.
+   * Decrements decay time by the duration of a frame and returns whether
+   * it is time to refresh the wave plot.
    *
+   * \param elapsedSeconds Seconds elapsed since the previous frame.
    * \return true if decayTime <= 0.
    * \return false otherwise.
    */
-  bool refreshNeeded();
+  bool refreshNeeded(double elapsedSeconds);
 
   /**
-   * Resets decay time to framesPerSeconds * decaySeconds
+   * Resets decay time to decaySeconds
    *
    */
   void resetDecayTime();
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    DisplayHistory.cpp
+    Created: 18 Oct 2026 7:41:26pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "DisplayHistory.h"
+
+void DisplayHistory::setSize(int numChannels, size_t newLength)
+{
+  // reallocate only if needed, always clear
+  rings.resize((size_t)numChannels);
+  for (auto &ring : rings)
+  {
+    ring.assign(2 * newLength, 0.f);
+  }
+  length = newLength;
+  head = 0;
+}
+
+size_t DisplayHistory::getLength() const
+{
+  return length;
+}
+
+void DisplayHistory::write(int channel, const float *values, size_t numValues)
+{
+  auto &ring = rings[(size_t)channel];
+  numValues = std::min(numValues, length);
+
+  // write each copy in at most two spans
+  auto size1 = std::min(numValues, length - head);
+  for (auto copy : {ring.data(), ring.data() + length})
+  {
+    std::copy(values, values + size1, copy + head);
+    std::copy(values + size1, values + numValues, copy);
+  }
+}
+
+void DisplayHistory::advance(size_t numValues)
+{
+  if (length > 0)
+  {
+    head = (head + std::min(numValues, length)) % length;
+  }
+}
+
+const float *DisplayHistory::getWindow(int channel) const
+{
+  return rings[(size_t)channel].data() + head;
+}
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    DisplayHistory.h
+    Created: 18 Oct 2026 7:41:26pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * Scrolling window of displayed columns, one per channel.
+ *
+ * Each channel is a ring addressed by a head index shared by all channels.
+ * Every value is written twice, at its ring position and one ring length
+ * further, so that the whole window is always readable as one contiguous
+ * span starting at the head. Scrolling by n columns thus costs O(n) instead of
+ * shifting the whole window.
+ *
+ */
+class DisplayHistory
+{
+public:
+  /**
+   * Resizes and clears the window.
+   *
+   * \param numChannels Number of channels.
+   * \param length Number of columns per channel.
+   */
+  void setSize(int numChannels, size_t length);
+
+  /**
+   * Get the number of columns per channel.
+   *
+   * \return size_t Window length.
+   */
+  size_t getLength() const;
+
+  /**
+   * Writes the newest columns of a channel at the head, without advancing it.
+   *
+   * \param channel Channel index.
+   * \param values New columns, oldest first.
+   * \param numValues Number of new columns, at most the window length.
+   */
+  void write(int channel, const float *values, size_t numValues);
+
+  /**
+   * Advances the head of every channel past the columns just written.
+   *
+   * \param numValues Number of columns written to each channel.
+   */
+  void advance(size_t numValues);
+
+  /**
+   * Get the window of a channel.
+   *
+   * \param channel Channel index.
+   * \return const float* getLength() contiguous columns, oldest first.
+   */
+  const float *getWindow(int channel) const;
+
+private:
+  std::vector<std::vector<float>> rings; /**< Twice-written ring of each channel, 2 * length long */
+  size_t length = 0;                     /**< Columns per channel */
+  size_t head = 0;                       /**< Position of the oldest column */
+};
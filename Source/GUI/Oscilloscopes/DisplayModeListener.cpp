@@ -0,0 +1,23 @@
+/*
+  ==============================================================================
+
+    DisplayModeListener.cpp
+    Created: 18 Oct 2026 11:48:19pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "DisplayModeListener.h"
+
+DisplayModeListener::DisplayModeListener(std::function<void(Mode)> setMode)
+{
+  // set lambda
+  this->setMode = setMode;
+}
+
+void DisplayModeListener::parameterChanged(const juce::String &parameterID, float newValue)
+{
+  // choice parameters report their index
+  setMode((Mode)juce::roundToInt(newValue));
+}
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    DisplayModeListener.h
+    Created: 18 Oct 2026 11:48:19pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <functional>
+
+/**
+ * Class listening to the displayMode parameter and resetting the
+ * OscilloscopeComponent properly.
+ *
+ */
+class DisplayModeListener : public juce::AudioProcessorValueTreeState::Listener
+{
+public:
+  /**
+   * Displayed views, in the order of the displayMode parameter's choices.
+   */
+  enum class Mode
+  {
+    scope,       /**< Waveform, triggered or not */
+    spectrum,    /**< Magnitude spectrum */
+    spectrogram, /**< Scrolling history of spectra */
+    xy,          /**< Left against right */
+    goniometer   /**< Mid against side */
+  };
+
+  /**
+   * Construct a new Display Mode Listener object
+   *
+   * \param setMode Lambda to call when the display mode changed.
+   */
+  DisplayModeListener(std::function<void(Mode)> setMode);
+
+  /**
+   * Callback executed each time displayMode param of PluginProcessors' TreeState
+   * is modified.
+   *
+   * \param parameterID Parameter ID, always "displayMode"
+   * \param newValue Index of the new display mode.
+   */
+  void parameterChanged(const juce::String &parameterID, float newValue) override;
+
+private:
+  /**
+   * Lambda to execute when the display mode changed.
+   *
+   */
+  std::function<void(Mode)> setMode;
+};
@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+    DisplayResampler.cpp
+    Created: 18 Oct 2026 9:07:44pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "DisplayResampler.h"
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define OSCILLOSCOPE_RESAMPLER_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OSCILLOSCOPE_RESAMPLER_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define OSCILLOSCOPE_RESAMPLER_NEON 1
+#endif
+
+namespace
+{
+  /**
+   * Reads a sample, clamping the index to the input.
+   *
+   * \param input Samples.
+   * \param numInput Number of samples.
+   * \param index Index to read.
+   * \return float Sample at the clamped index.
+   */
+  inline float clampedSample(const float *input, int numInput, int index)
+  {
+    return input[juce::jlimit(0, numInput - 1, index)];
+  }
+}
+
+void DisplayResampler::setEngine(Engine newEngine)
+{
+  engine = newEngine;
+}
+
+DisplayResampler::Engine DisplayResampler::getEngine() const
+{
+  return engine;
+}
+
+void DisplayResampler::process(const float *input, int numInput, double start, double step, float *output, int numOutput) const
+{
+  // nothing to interpolate
+  if (numInput <= 0 || numOutput <= 0)
+  {
+    return;
+  }
+
+  switch (engine)
+  {
+  case Engine::linear:
+  {
+    for (int i = 0; i < numOutput; ++i)
+    {
+      auto position = start + i * step;
+      auto index = (int)std::floor(position);
+      auto fraction = float(position - index);
+      auto a = clampedSample(input, numInput, index);
+      auto b = clampedSample(input, numInput, index + 1);
+      output[i] = a + fraction * (b - a);
+    }
+    break;
+  }
+  case Engine::cubic:
+  {
+    for (int i = 0; i < numOutput; ++i)
+    {
+      auto position = start + i * step;
+      auto index = (int)std::floor(position);
+      auto f = float(position - index);
+
+      // 4-point Lagrange basis at -1, 0, 1, 2
+      auto c0 = -f * (f - 1.f) * (f - 2.f) / 6.f;
+      auto c1 = (f + 1.f) * (f - 1.f) * (f - 2.f) / 2.f;
+      auto c2 = -(f + 1.f) * f * (f - 2.f) / 2.f;
+      auto c3 = (f + 1.f) * f * (f - 1.f) / 6.f;
+      output[i] = c0 * clampedSample(input, numInput, index - 1) + c1 * clampedSample(input, numInput, index) + c2 * clampedSample(input, numInput, index + 1) + c3 * clampedSample(input, numInput, index + 2);
+    }
+    break;
+  }
+  case Engine::sinc:
+  {
+    auto &table = getSincTable();
+    float edge[numTaps];
+    for (int i = 0; i < numOutput; ++i)
+    {
+      auto position = start + i * step;
+      auto index = (int)std::floor(position);
+      auto phase = (int)std::lround((position - index) * numPhases);
+      auto coefficients = table.data() + (size_t)phase * numTaps;
+
+      // taps entirely inside the input are read in place, others are clamped
+      auto first = index - (numTaps / 2 - 1);
+      if (first >= 0 && first + numTaps <= numInput)
+      {
+        output[i] = dotProduct(input + first, coefficients);
+      }
+      else
+      {
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+          edge[tap] = clampedSample(input, numInput, first + tap);
+        }
+        output[i] = dotProduct(edge, coefficients);
+      }
+    }
+    break;
+  }
+  }
+}
+
+const std::vector<float> &DisplayResampler::getSincTable()
+{
+  static const std::vector<float> table = makeSincTable();
+  return table;
+}
+
+std::vector<float> DisplayResampler::makeSincTable()
+{
+  // one extra phase, so that rounding the fraction up needs no wrap
+  std::vector<float> table((size_t)(numPhases + 1) * numTaps);
+  for (int phase = 0; phase <= numPhases; ++phase)
+  {
+    auto row = table.data() + (size_t)phase * numTaps;
+    double sum = 0.;
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+      // distance from the interpolated position, window spanning every tap
+      auto distance = double(tap - (numTaps / 2 - 1)) - double(phase) / numPhases;
+      auto x = juce::MathConstants<double>::pi * distance;
+      auto sinc = std::abs(distance) < 1.0e-9 ? 1. : std::sin(x) / x;
+      auto n = juce::MathConstants<double>::twoPi * (distance + numTaps / 2) / numTaps;
+      auto window = 0.35875 - 0.48829 * std::cos(n) + 0.14128 * std::cos(2. * n) - 0.01168 * std::cos(3. * n);
+      row[tap] = float(sinc * window);
+      sum += sinc * window;
+    }
+
+    // unity gain at DC
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+      row[tap] = float(row[tap] / sum);
+    }
+  }
+  return table;
+}
+
+float DisplayResampler::dotProduct(const float *samples, const float *coefficients)
+{
+  static_assert(numTaps == 16, "vector paths assume 16 taps");
+
+#if OSCILLOSCOPE_RESAMPLER_AVX
+  auto sum = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(samples), _mm256_loadu_ps(coefficients)),
+                           _mm256_mul_ps(_mm256_loadu_ps(samples + 8), _mm256_loadu_ps(coefficients + 8)));
+  auto half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+  half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+  half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+  return _mm_cvtss_f32(half);
+#elif OSCILLOSCOPE_RESAMPLER_SSE2
+  auto sum = _mm_mul_ps(_mm_loadu_ps(samples), _mm_loadu_ps(coefficients));
+  sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(samples + 4), _mm_loadu_ps(coefficients + 4)));
+  sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(samples + 8), _mm_loadu_ps(coefficients + 8)));
+  sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(samples + 12), _mm_loadu_ps(coefficients + 12)));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  return _mm_cvtss_f32(sum);
+#elif OSCILLOSCOPE_RESAMPLER_NEON
+  auto sum = vmulq_f32(vld1q_f32(samples), vld1q_f32(coefficients));
+  sum = vmlaq_f32(sum, vld1q_f32(samples + 4), vld1q_f32(coefficients + 4));
+  sum = vmlaq_f32(sum, vld1q_f32(samples + 8), vld1q_f32(coefficients + 8));
+  sum = vmlaq_f32(sum, vld1q_f32(samples + 12), vld1q_f32(coefficients + 12));
+  return vaddvq_f32(sum);
+#else
+  float sum = 0.f;
+  for (int tap = 0; tap < numTaps; ++tap)
+  {
+    sum += samples[tap] * coefficients[tap];
+  }
+  return sum;
+#endif
+}
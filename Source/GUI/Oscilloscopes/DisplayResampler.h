@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    DisplayResampler.h
+    Created: 18 Oct 2026 9:07:44pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * Reconstructs a waveform between its samples, for displays showing fewer
+ * samples than pixel columns.
+ *
+ * Three engines trade cost for accuracy: linear interpolation, 4-point cubic
+ * Lagrange interpolation and a 16-tap polyphase windowed sinc. Sinc
+ * coefficients are computed once for all phases and shared by every instance,
+ * so that resampling a frame costs one SIMD dot product per output point.
+ *
+ */
+class DisplayResampler
+{
+public:
+  /**
+   * Interpolation engines, in the order of the resampler parameter choices.
+   */
+  enum class Engine
+  {
+    linear,
+    cubic,
+    sinc
+  };
+
+  static constexpr int numTaps = 16;    /**< Sinc taps, half of them on each side of the interpolated position */
+  static constexpr int numPhases = 256; /**< Sinc fractional positions with precomputed coefficients */
+
+  /**
+   * Sets the engine used by @ref process.
+   *
+   * \param newEngine Engine to use.
+   */
+  void setEngine(Engine newEngine);
+
+  /**
+   * Get the engine used by @ref process.
+   *
+   * \return Engine Current engine.
+   */
+  Engine getEngine() const;
+
+  /**
+   * Interpolates input at the positions start + i * step. Samples outside the
+   * input are taken equal to its first or last one.
+   *
+   * \param input Samples to interpolate.
+   * \param numInput Number of samples.
+   * \param start Position of the first output point, in samples.
+   * \param step Distance between two output points, in samples.
+   * \param output Where to write the interpolated points.
+   * \param numOutput Number of points to write.
+   */
+  void process(const float *input, int numInput, double start, double step, float *output, int numOutput) const;
+
+private:
+  Engine engine = Engine::linear; /**< Engine used by process */
+
+  /**
+   * Get the sinc coefficients, numTaps per phase for numPhases + 1 phases,
+   * computed on first use.
+   *
+   * \return const std::vector<float>& Coefficient table.
+   */
+  static const std::vector<float> &getSincTable();
+
+  /**
+   * Computes the sinc coefficient table: a Blackman-Harris windowed sinc,
+   * each phase normalised to unity gain at DC.
+   *
+   * \return std::vector<float> Coefficient table.
+   */
+  static std::vector<float> makeSincTable();
+
+  /**
+   * Dot product of numTaps samples and coefficients.
+   *
+   * \param samples Samples.
+   * \param coefficients Coefficients of one phase.
+   * \return float Interpolated value.
+   */
+  static float dotProduct(const float *samples, const float *coefficients);
+};
@@ -12,46 +12,43 @@
 
 OscilloscopeComponent::OscilloscopeComponent(OscilloscopeAudioProcessor &aProcessor, int sampleRate, int framesPerSecond) : audioProcessor(aProcessor)
 {
-    // set frames per second
-    setFramesPerSecond(framesPerSecond);
-
     // set attributes
     this->sampleRate = sampleRate;
-    displayLength = (int)(*aProcessor.getTreeState()->getRawParameterValue("bufferLength") * aProcessor.getSampleRate());
-    ratio = (double)displayLength / (double)EDITOR_INITIAL_WIDTH();
-    displayLength /= ratio;
+    parameters = aProcessor.getParameterCache().getSnapshot();
+    windowSeconds = parameters.bufferLength;
+    pixelWidth = EDITOR_INITIAL_WIDTH();
+    displayLength = pixelWidth;
+
+    // read the capture buffers until destruction
+    captureReader = aProcessor.getCaptureResources().attachReader();
+    capture = &aProcessor.getCaptureResources().acquire(captureReader);
+    captureEpoch = capture->epoch;
 
-    // resize buffers
-    double dataLength = audioProcessor.getAudioBufferQueue()->getBufferSize() / ratio;
-    sampleData.resize(EDITOR_INITIAL_WIDTH());
-    newData.resize(sampleData.size());
-    newlyPopped.resize(dataLength);
-    notInterpolatedData.resize(audioProcessor.getAudioBufferQueue()->getBufferSize());
+    // resize & clear buffers of every channel
+    resizeBuffers();
 
-    // fill all buffers with 0
-    std::fill(sampleData.begin(), sampleData.end(), 0);
-    std::fill(newlyPopped.begin(), newlyPopped.end(), 0);
-    std::fill(notInterpolatedData.begin(), notInterpolatedData.end(), 0);
-    std::fill(newData.begin(), newData.end(), 0);
+    // render mode is polled every frame
+    updateRenderMode();
 
-    // add this as listener
-    aProcessor.getTreeState()->addParameterListener("bufferLength", this);
+    // start frames
+    scheduler.reset(new RefreshScheduler(*this, framesPerSecond, [this](double elapsedSeconds)
+                                         { frameCallback(elapsedSeconds); }));
 
-    // reset interpolator
-    interpolator.reset();
+    // wake up at once when the input stops being quiet
+    scheduler->setWakeCheck([this]()
+                            { return capture->buffers->collector.getActivity().getNumWakes() != seenWakes; });
 }
 
 OscilloscopeComponent::~OscilloscopeComponent()
 {
-    // remove this as listener
-    audioProcessor.getTreeState()->removeParameterListener("bufferLength", this);
+    audioProcessor.getCaptureResources().detachReader(captureReader);
 }
 
 void OscilloscopeComponent::setFramesPerSecond(int framesPerSecond)
 {
-    // start timer
+    // cap the adaptive rate
     jassert(framesPerSecond > 0 && framesPerSecond < 1000);
-    startTimerHz(framesPerSecond);
+    scheduler->setMaximumRate(framesPerSecond);
 }
 
 void OscilloscopeComponent::drawGrid(juce::Graphics &g, float w, float h)
@@ -73,10 +70,9 @@ void OscilloscopeComponent::drawGrid(juce::Graphics &g, float w, float h)
 
     // get duration of each x tick
     float fontHeight = g.getCurrentFont().getAscent();
-    float duration = *audioProcessor.getTreeState()->getRawParameterValue("bufferLength") * static_cast<float>(10000);
+    float duration = parameters.bufferLength * static_cast<float>(10000);
     duration /= 10;
-    auto xText = juce::String(duration, 2);
-    xText.append(" ms", 3);
+    auto xText = duration < 1000 ? juce::String(duration, 2) + " ms" : juce::String(duration / 1000, 2) + " s";
 
     // write x ticks values
     g.drawLine(w - 95, h - 39, w - 95, h - 39 - fontHeight);
@@ -104,51 +100,423 @@ void OscilloscopeComponent::paint(juce::Graphics &g)
     auto w = (float)area.getWidth();
 
     // draw grid if necessary
-    if (audioProcessor.getTreeState()->getParameterAsValue("drawGrid").getValue())
+    if (parameters.drawGrid)
     {
         drawGrid(g, w, h);
     }
 
-    // draw waveform
+    // draw cached waveform, or just blit it if it is rendered in background
     auto scopeRect = juce::Rectangle<float>{float(0), float(0), w, h};
-    plot(g, scopeRect, float(1), h / 2);
+    if (wasPersistent)
+    {
+        g.drawImageAt(phosphorImage, 0, 0);
+        plotOverlay(g, scopeRect, float(1), h / 2);
+    }
+    else if (traceRenderer != nullptr)
+    {
+        if (auto image = traceRenderer->acquireLatest())
+        {
+            g.drawImageAt(*image, 0, 0);
+        }
+        plotOverlay(g, scopeRect, float(1), h / 2);
+    }
+    else
+    {
+        plot(g, scopeRect, float(1), h / 2);
+    }
+
+    // debug overlay on top of everything
+    if (showStatistics)
+    {
+        drawStatistics(g);
+    }
+}
+
+void OscilloscopeComponent::drawStatistics(juce::Graphics &g)
+{
+    auto statistics = audioProcessor.getStatistics().getSnapshot();
+
+    // counters
+    juce::StringArray lines;
+    lines.add("load " + juce::String(statistics.getAverageLoad() * 100., 2) + " %, max block " + juce::String(statistics.maxBlockSeconds * 1000., 3) + " ms");
+    lines.add("dropped samples " + juce::String((juce::int64)statistics.numDroppedSamples) + ", empty pops " + juce::String((juce::int64)statistics.numEmptyPops));
+    lines.add("triggers " + juce::String(statistics.getTriggerRate(), 1) + " /s");
+
+    // disk recorder, once it has been used
+    auto recording = audioProcessor.getRecorder().getSnapshot();
+    if (recording.isRecording || recording.numWrittenSamples > 0)
+    {
+        lines.add(juce::String(recording.isClosing ? "closing, " : "") + "recorded " + juce::String(recording.getRecordedSeconds(), 1) + " s, " + juce::String(recording.getWriteThroughput() / 1.0e6, 1) + " MB/s, ring " + juce::String(recording.maxFill * 100., 1) + " %");
+        lines.add("overruns " + juce::String((juce::int64)recording.numOverruns) + ", unrecorded samples " + juce::String((juce::int64)recording.numDroppedSamples));
+    }
+
+    // panel in the top left corner
+    auto lineHeight = 14;
+    auto histogramHeight = 40;
+    auto area = juce::Rectangle<int>(8, 8, 260, lines.size() * lineHeight + histogramHeight + 16);
+    g.setColour(juce::Colours::black.withAlpha(0.7f));
+    g.fillRect(area);
+    g.setColour(juce::Colours::white);
+    g.setFont(12.f);
+    auto textArea = area.reduced(4);
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        g.drawText(lines[i], textArea.removeFromTop(lineHeight), juce::Justification::centredLeft, true);
+    }
+
+    // load histogram, one bar per bucket, scaled to the largest one
+    juce::uint64 largest = 1;
+    for (auto count : statistics.loadHistogram)
+    {
+        largest = std::max(largest, count);
+    }
+    auto histogramArea = textArea.removeFromTop(histogramHeight).toFloat();
+    auto barWidth = histogramArea.getWidth() / StatisticsSnapshot::numLoadBuckets;
+    for (int bucket = 0; bucket < StatisticsSnapshot::numLoadBuckets; ++bucket)
+    {
+        auto barHeight = histogramArea.getHeight() * float(statistics.loadHistogram[(size_t)bucket]) / float(largest);
+        g.setColour(bucket < StatisticsSnapshot::numLoadBuckets - 1 ? juce::Colours::lightgreen : juce::Colours::red);
+        g.fillRect(histogramArea.getX() + bucket * barWidth + 1.f, histogramArea.getBottom() - barHeight, barWidth - 2.f, barHeight);
+    }
+}
+
+void OscilloscopeComponent::mouseDoubleClick(const juce::MouseEvent &)
+{
+    // toggle the debug overlay
+    showStatistics = !showStatistics;
+    repaint();
 }
 
 void OscilloscopeComponent::resized()
 {
+    // one column per physical pixel, buffers are resized by the next frame
+    pixelWidth = getPhysicalWidth();
+
+    // geometry depends on bounds
+    tracesNeedUpdate = true;
+}
+
+int OscilloscopeComponent::getPhysicalWidth() const
+{
+    // transforms & desktop scale, then the DPI scale of the monitor showing the component
+    auto scale = (double)juce::Component::getApproximateScaleFactorForComponent(this);
+    if (auto display = juce::Desktop::getInstance().getDisplays().getDisplayForRect(getScreenBounds()))
+    {
+        scale *= display->scale;
+    }
+    return std::max(2, juce::roundToInt(getWidth() * scale));
+}
+
+void OscilloscopeComponent::updateLayout()
+{
+    // moving the window to another monitor changes the scale without resizing
+    pixelWidth = getPhysicalWidth();
+
+    // nothing changed since buffers were sized
+    if (parameters.bufferLength == windowSeconds && pixelWidth == displayLength)
+    {
+        return;
+    }
+
+    windowSeconds = parameters.bufferLength;
+    displayLength = pixelWidth;
+    resizeBuffers();
+}
+
+void OscilloscopeComponent::resizeBuffers()
+{
+    numChannels = capture->geometry.numChannels;
+    ratio = windowSeconds * capture->geometry.sampleRate / displayLength;
+
+    // pending samples: the window, the support of the resampler and one column
+    windowSamples = (size_t)std::ceil(displayLength * ratio);
+    auto pendingLength = windowSamples + (size_t)DisplayResampler::numTaps + (size_t)std::ceil(std::max(ratio, 1.)) + 1;
+    numPending = 0;
+    nextColumn = 0.;
+    summariesAreStatic = false;
+
+    // one set of buffers per channel
+    sampleData.setSize(numChannels, (size_t)displayLength);
+    minData.setSize(numChannels, (size_t)displayLength);
+    maxData.setSize(numChannels, (size_t)displayLength);
+    summaryMin.resize((size_t)displayLength);
+    summaryMax.resize((size_t)displayLength);
+    summaryCentre.resize((size_t)displayLength);
+    newlyPopped.resize((size_t)numChannels);
+    newlyPoppedMin.resize(newlyPopped.size());
+    newlyPoppedMax.resize(newlyPopped.size());
+    notInterpolatedData.resize(newlyPopped.size());
+    notInterpolatedPointers.resize(newlyPopped.size());
+
+    for (size_t channel = 0; channel < newlyPopped.size(); ++channel)
+    {
+        newlyPopped[channel].resize((size_t)displayLength);
+        newlyPoppedMin[channel].resize((size_t)displayLength);
+        newlyPoppedMax[channel].resize((size_t)displayLength);
+        notInterpolatedData[channel].resize(pendingLength);
+    }
+    tracesNeedUpdate = true;
+    layoutChanged();
+}
+
+void OscilloscopeComponent::updateCapture()
+{
+    // valid until the next acquire
+    capture = &audioProcessor.getCaptureResources().acquire(captureReader);
+    if (capture->epoch == captureEpoch)
+    {
+        return;
+    }
+
+    // samples queued at the previous geometry are meaningless
+    captureEpoch = capture->epoch;
+    capture->buffers->queue.flush();
+    captureChanged();
+    resizeBuffers();
+}
+
+void OscilloscopeComponent::updateRenderMode()
+{
+    // start or stop the worker when the parameter changed
+    auto shouldRenderInBackground = parameters.backgroundRender && drawsTraces();
+    if (shouldRenderInBackground == (traceRenderer != nullptr))
+    {
+        return;
+    }
+
+    traceRenderer.reset(shouldRenderInBackground ? new TraceRenderer() : nullptr);
+    tracesNeedUpdate = true;
+}
+
+bool OscilloscopeComponent::isPersistent() const
+{
+    return parameters.persistence && drawsTraces();
 }
 
-void OscilloscopeComponent::parameterChanged(const juce::String &parameterID, float newValue)
+bool OscilloscopeComponent::updatePersistence(double elapsedSeconds)
 {
-    // resize buffers to new length
-    ratio = newValue * audioProcessor.getSampleRate() / EDITOR_INITIAL_WIDTH();
-    displayLength = newValue * audioProcessor.getSampleRate() / ratio;
-    sampleData.resize(displayLength);
-    newData.resize(sampleData.size());
-    int queueSize = audioProcessor.getAudioBufferQueue()->getBufferSize();
-    double dataLength = queueSize / ratio;
-    newlyPopped.resize(dataLength);
+    // start from black when entering persistence, rebuild traces when leaving it
+    auto persistent = isPersistent();
+    if (persistent != wasPersistent)
+    {
+        phosphorBuffer.clear();
+        tracesNeedUpdate = true;
+        wasPersistent = persistent;
+    }
+    if (!persistent)
+    {
+        return false;
+    }
+
+    // a faded phosphor stays black until new data arrives
+    auto persistenceTime = std::max(0.05f, parameters.decayTime) * OSCILLOSCOPE_MAX_PERSISTENCE_TIME();
+    if (!tracesNeedUpdate && fadingSeconds > fadeOutTimeConstants * persistenceTime)
+    {
+        return false;
+    }
+    fadingSeconds += float(elapsedSeconds);
+
+    // exponential decay over the persistence time
+    phosphorBuffer.setSize(getWidth(), getHeight());
+    phosphorBuffer.decay(std::exp(-float(elapsedSeconds) / persistenceTime));
+
+    // splat new data once
+    if (tracesNeedUpdate)
+    {
+        splat(phosphorBuffer, getLocalBounds().toFloat(), float(1), getHeight() / 2.f);
+        tracesNeedUpdate = false;
+        fadingSeconds = 0.f;
+    }
+
+    phosphorBuffer.toneMap(phosphorImage);
+    return true;
 }
 
-void OscilloscopeComponent::timerCallback()
+int OscilloscopeComponent::getNumColumns() const
 {
-    // pop raw data
-    audioProcessor.getAudioBufferQueue()->pop(notInterpolatedData.data());
-    int queueSize = newlyPopped.size();
+    return (int)sampleData.getLength();
+}
 
-    // resample data
-    interpolator.process(ratio, notInterpolatedData.data(), newlyPopped.data(), queueSize);
+void OscilloscopeComponent::frameCallback(double elapsedSeconds)
+{
+    // read every parameter once for this frame
+    parameters = audioProcessor.getParameterCache().getSnapshot();
+    resampler.setEngine((DisplayResampler::Engine)parameters.resampler);
 
-    // shift & add new data
-    std::copy(sampleData.data() + queueSize, sampleData.data() + sampleData.size(), newData.begin());
-    std::copy(newlyPopped.data(), newlyPopped.data() + queueSize, newData.begin() + sampleData.size() - queueSize);
+    // follow render mode & reconfigurations of the processor
+    updateRenderMode();
+    updateCapture();
+    updateLayout();
 
-    // set data to plot equal to shifted data
-    sampleData = newData;
+    // consume the captured data
+    renderCapture();
 
     // perform subclass-specific operations
-    subclassSpecificCallback();
+    subclassSpecificCallback(elapsedSeconds);
 
-    // repaint
-    repaint();
+    // accumulate traces instead of drawing them in persistence mode
+    auto hasChanged = tracesNeedUpdate;
+    hasChanged = updatePersistence(elapsedSeconds) || hasChanged;
+
+    // frames slow down while nothing changes
+    scheduler->reportActivity(hasChanged);
+    seenWakes = capture->buffers->collector.getActivity().getNumWakes();
+
+    // rebuild geometry once per new frame, so that paint only fills it
+    if (tracesNeedUpdate)
+    {
+        auto h = (float)getHeight();
+        traces.resize((size_t)numChannels);
+        updateTraces(getLocalBounds().toFloat(), float(1), h / 2);
+        tracesNeedUpdate = false;
+
+        // hand them to the worker thread if rendering in background
+        if (traceRenderer != nullptr)
+        {
+            traceRenderer->submit(traces, getWidth(), getHeight());
+        }
+    }
+
+    // repaint only when something changed, the worker needs a few more frames to deliver its image
+    if (hasChanged)
+    {
+        numRepaintsPending = traceRenderer != nullptr ? maxFramesPerRender : 1;
+    }
+    if (numRepaintsPending > 0 || showStatistics)
+    {
+        numRepaintsPending = std::max(0, numRepaintsPending - 1);
+        repaint();
+    }
+}
+
+void OscilloscopeComponent::renderCapture()
+{
+    // long windows are rendered from the summary pyramid
+    if (windowSeconds > OSCILLOSCOPE_MAX_RAW_LENGTH())
+    {
+        renderFromSummaries();
+    }
+    else
+    {
+        renderFromSamples();
+    }
+}
+
+void OscilloscopeComponent::renderFromSamples()
+{
+    auto queue = &capture->buffers->queue;
+    auto margin = (size_t)DisplayResampler::numTaps / 2;
+
+    // samples older than the window would scroll out at once, pending ones are not contiguous anymore
+    auto numReady = queue->getNumReady();
+    if (numReady > windowSamples)
+    {
+        queue->discard(numReady - windowSamples);
+        numReady = windowSamples;
+        numPending = 0;
+        nextColumn = 0.;
+    }
+
+    // append whatever arrived since the previous frame to the pending samples
+    auto numToPop = std::min(numReady, notInterpolatedData[0].size() - numPending);
+    for (size_t channel = 0; channel < notInterpolatedData.size(); ++channel)
+    {
+        notInterpolatedPointers[channel] = notInterpolatedData[channel].data() + numPending;
+    }
+    numPending += queue->pop(notInterpolatedPointers.data(), numToPop);
+
+    // columns whose samples and resampling support have all arrived
+    auto span = std::max(ratio, 1.);
+    auto lastStart = double(numPending) - double(margin) - span;
+    if (lastStart < nextColumn)
+    {
+        // the audio thread did not deliver a single column, as expected once the input went quiet
+        if (!capture->buffers->collector.getActivity().isQuiet())
+        {
+            audioProcessor.getStatistics().recordEmptyPop();
+        }
+        return;
+    }
+    auto numNew = (size_t)std::floor((lastStart - nextColumn) / ratio) + 1;
+
+    // only the most recent columns can be displayed
+    auto numColumns = (size_t)getNumColumns();
+    if (numNew > numColumns)
+    {
+        nextColumn += double(numNew - numColumns) * ratio;
+        numNew = numColumns;
+    }
+    tracesNeedUpdate = true;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        // resample data, the pending samples hold the support on both sides
+        auto pending = notInterpolatedData[channel].data();
+        resampler.process(pending, (int)numPending, nextColumn, ratio, newlyPopped[channel].data(), (int)numNew);
+        sampleData.write(channel, newlyPopped[channel].data(), numNew);
+
+        // zoomed in every column is a point of the reconstructed waveform
+        if (ratio < 1.)
+        {
+            minData.write(channel, newlyPopped[channel].data(), numNew);
+            maxData.write(channel, newlyPopped[channel].data(), numNew);
+            continue;
+        }
+
+        // zoomed out reduce it to its peak envelope
+        auto first = (size_t)nextColumn;
+        auto end = std::min(numPending, (size_t)(nextColumn + double(numNew) * ratio));
+        PeakDecimator::process(pending + first, (int)(end - first), newlyPoppedMin[channel].data(), newlyPoppedMax[channel].data(), (int)numNew);
+        minData.write(channel, newlyPoppedMin[channel].data(), numNew);
+        maxData.write(channel, newlyPoppedMax[channel].data(), numNew);
+    }
+
+    // scroll by moving the head only
+    sampleData.advance(numNew);
+    minData.advance(numNew);
+    maxData.advance(numNew);
+
+    // keep the left support of the next column, drop older samples
+    nextColumn += double(numNew) * ratio;
+    auto numDone = (size_t)std::max(0., std::floor(nextColumn) - double(margin));
+    numDone = std::min(numDone, numPending);
+    for (auto &pending : notInterpolatedData)
+    {
+        std::copy(pending.begin() + (std::ptrdiff_t)numDone, pending.begin() + (std::ptrdiff_t)numPending, pending.begin());
+    }
+    numPending -= numDone;
+    nextColumn -= double(numDone);
+}
+
+void OscilloscopeComponent::renderFromSummaries()
+{
+    // raw samples are not needed
+    capture->buffers->queue.flush();
+
+    // a window that has been silent all along was rendered already
+    auto silentSeconds = double(capture->buffers->collector.getActivity().getNumSilentSamples()) / capture->geometry.sampleRate;
+    auto isStatic = silentSeconds >= windowSeconds;
+    if (isStatic && summariesAreStatic)
+    {
+        return;
+    }
+    summariesAreStatic = isStatic;
+
+    // render the whole window of every channel
+    tracesNeedUpdate = true;
+    auto windowLength = (size_t)(windowSeconds * capture->geometry.sampleRate);
+    auto numColumns = getNumColumns();
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        capture->buffers->getPyramid(channel)->render(windowLength, numColumns, summaryMin.data(), summaryMax.data());
+
+        // centre of the envelope as trace
+        juce::FloatVectorOperations::add(summaryCentre.data(), summaryMin.data(), summaryMax.data(), numColumns);
+        juce::FloatVectorOperations::multiply(summaryCentre.data(), 0.5f, numColumns);
+
+        // replace the whole window
+        sampleData.write(channel, summaryCentre.data(), (size_t)numColumns);
+        minData.write(channel, summaryMin.data(), (size_t)numColumns);
+        maxData.write(channel, summaryMax.data(), (size_t)numColumns);
+    }
 }
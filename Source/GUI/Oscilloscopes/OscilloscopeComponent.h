@@ -10,24 +10,33 @@
 
 #pragma once
 #include <JuceHeader.h>
-#include "../../Buffers/AudioBufferQueue.h"
 #include "../../PluginProcessor.h"
 #include "../../InitVariables.h"
+#include "../ColorPalette.h"
+#include "PeakDecimator.h"
+#include "TracePath.h"
+#include "TraceRenderer.h"
+#include "PhosphorBuffer.h"
+#include "DisplayHistory.h"
+#include "DisplayResampler.h"
+#include "RefreshScheduler.h"
 
 /**
  * Oscilloscope graphical component.
  *
- * Inherits from <a href="https://docs.juce.com/master/classComponent.html">JUCE Component</a>
- * and <a href="https://docs.juce.com/master/classTimer.html">JUCE timer</a>
+ * Inherits from <a href="https://docs.juce.com/master/classComponent.html">JUCE Component</a>.
+ * Frames are paced by a @ref RefreshScheduler.
  */
-class OscilloscopeComponent : public juce::Component, public juce::AudioProcessorValueTreeState::Listener, private juce::Timer
+class OscilloscopeComponent : public juce::Component
 {
 public:
   //==============================================================================
   /**
    * Constructor.
    *
-   * \param queueToUse AudioBufferQueue to use
+   * \param aProcessor Processor to display.
+   * \param sampleRate Sample rate.
+   * \param framesPerSecond Highest frame rate.
    */
   OscilloscopeComponent(OscilloscopeAudioProcessor &aProcessor, int sampleRate, int framesPerSecond);
 
@@ -39,7 +48,8 @@ public:
 
   //==============================================================================
   /**
-   * Sets frames per seconds.
+   * Sets the highest frame rate. The actual rate adapts to the display, to
+   * the content and to the CPU cost of frames.
    *
    * \param framesPerSecond Frames per second
    */
@@ -54,7 +64,7 @@ public:
    * \param w width.
    * \param h heigth.
    */
-  void drawGrid(juce::Graphics &g, float w, float h);
+  virtual void drawGrid(juce::Graphics &g, float w, float h);
 
   /**
    * Paints the component.
@@ -65,50 +75,215 @@ public:
 
   //==============================================================================
   /**
-   * Called when component is resized.
+   * Called when component is resized. Buffers follow the new width at the
+   * next frame.
    *
    */
   void resized() override;
 
+  /**
+   * Toggles the statistics overlay.
+   *
+   * \param event Mouse event.
+   */
+  void mouseDoubleClick(const juce::MouseEvent &event) override;
+
 protected:
-  int sampleRate;                /**< Sample rate */
-  std::vector<float> sampleData; /**< Data currently displayed */
+  int sampleRate;                             /**< Sample rate */
+  int numChannels = 1;                        /**< Number of displayed channels */
+  DisplayHistory sampleData;                  /**< Data currently displayed, per channel */
+  DisplayHistory minData;                     /**< Minimum of each displayed column, per channel */
+  DisplayHistory maxData;                     /**< Maximum of each displayed column, per channel */
   OscilloscopeAudioProcessor &audioProcessor;
+  ParameterSnapshot parameters;               /**< Parameters read at the last frame */
+  DisplayResampler resampler;                 /**< Reconstructs the waveform when zoomed in past the samples */
+
+  const CaptureResources<float>::State *capture = nullptr; /**< Capture buffers, acquired at the last frame */
+  int captureReader = -1;                                  /**< Reader id capture is acquired with */
+
+  std::vector<TracePath> traces;               /**< Cached geometry of each channel's trace */
+  bool tracesNeedUpdate = true;                /**< Whether traces must be rebuilt before the next repaint */
+
+  /**
+   * Get the number of displayed columns of each channel.
+   *
+   * \return int Number of columns.
+   */
+  int getNumColumns() const;
+
+  /**
+   * Returns whether the persistence display mode is on.
+   *
+   * \return true if traces are accumulated in the @ref PhosphorBuffer.
+   * \return false otherwise.
+   */
+  bool isPersistent() const;
+
+  /**
+   * Returns whether the view is drawn from @ref traces. Views painting their
+   * own images return false, so that neither the persistence buffer nor the
+   * TraceRenderer take their place.
+   *
+   * \return true if plot draws traces.
+   * \return false otherwise.
+   */
+  virtual bool drawsTraces() const { return true; }
 
 private:
   //==============================================================================
-  int displayLength;
-  std::vector<float> newlyPopped;         /**< Last popped array */
-  std::vector<float> notInterpolatedData; /** < Raw new data*/
-  std::vector<float> newData;             /** < Interpolated new data*/
+  int displayLength = 0;                                /**< Displayed columns, buffers are sized for */
+  int pixelWidth = 1;                                   /**< Width in physical pixels, set by resized & every frame */
+  float windowSeconds = 0.f;                            /**< Displayed window in seconds, buffers are sized for */
+  std::vector<std::vector<float>> newlyPopped;          /**< Last popped array, per channel */
+  std::vector<std::vector<float>> notInterpolatedData;  /** < Raw samples not yet fully displayed, per channel */
+  std::vector<float *> notInterpolatedPointers;         /**< End of the pending samples of each notInterpolatedData channel */
+  size_t numPending = 0;                                /**< Raw samples held in notInterpolatedData */
+  size_t windowSamples = 0;                             /**< Raw samples spanned by the displayed window */
+  double nextColumn = 0.;                               /**< Position of the next column in notInterpolatedData, in samples */
+  bool summariesAreStatic = false;                      /**< Whether the summaries were rendered from an all silent window */
+  std::vector<std::vector<float>> newlyPoppedMin;       /**< Minimum of each newly popped column, per channel */
+  std::vector<std::vector<float>> newlyPoppedMax;       /**< Maximum of each newly popped column, per channel */
+  std::vector<float> summaryMin;                        /**< Window rendered from a SummaryPyramid, minimum */
+  std::vector<float> summaryMax;                        /**< Window rendered from a SummaryPyramid, maximum */
+  std::vector<float> summaryCentre;                     /**< Window rendered from a SummaryPyramid, centre */
   double ratio = 1.;
-  juce::Interpolators::Linear interpolator;
+
+  std::unique_ptr<TraceRenderer> traceRenderer;                /**< Rasterises traces off the message thread, if enabled */
+
+  PhosphorBuffer phosphorBuffer{WAVEFORMCOLOUR()};             /**< Persistence accumulation buffer */
+  juce::Image phosphorImage;                                   /**< Tone-mapped phosphorBuffer */
+  bool wasPersistent = false;                                  /**< Persistence mode of the last timer callback */
+  bool showStatistics = false;                                 /**< Whether the statistics overlay is shown */
+  float fadingSeconds = 0.f;                                   /**< Time since new data was last splatted */
+  int numRepaintsPending = 0;                                  /**< Frames left to repaint after the last change */
+  juce::uint32 seenWakes = 0;                                  /**< Wake-up counter of the input at the last frame */
+
+  static constexpr float fadeOutTimeConstants = 6.f;           /**< Persistence time constants after which the phosphor is black */
+  static constexpr int maxFramesPerRender = 3;                 /**< Frames the TraceRenderer may take to deliver an image */
 
   /**
-   * Updates the buffer length when the parameter is modified.
+   * Draws the ProcessingStatistics of the processor: load, dropped samples,
+   * empty pops, trigger rate and a histogram of block processing time.
    *
-   * \param parameterID Parameter ID (always "bufferLength).
-   * \param newValue New value.
+   * \param g <a href="https://docs.juce.com/master/classGraphics.html">JUCE Graphics </a>.
    */
-  void parameterChanged(const juce::String &parameterID, float newValue) override;
+  void drawStatistics(juce::Graphics &g);
+
+  /**
+   * Decays the @ref phosphorBuffer, splats new traces into it and tone-maps it.
+   * Does nothing once it faded to black and no new data arrived.
+   *
+   * \param elapsedSeconds Seconds elapsed since the previous frame.
+   * \return true if the phosphor image changed.
+   * \return false otherwise.
+   */
+  bool updatePersistence(double elapsedSeconds);
+
+  juce::uint32 captureEpoch = 0;                               /**< Epoch of the geometry buffers are sized for */
+
+  /**
+   * Acquires the current capture buffers and, when the processor was
+   * reconfigured, flushes the stale samples and resizes buffers.
+   *
+   */
+  void updateCapture();
+
+  std::unique_ptr<RefreshScheduler> scheduler;                 /**< Paces frames, declared last so that it stops first */
+
+  /**
+   * Starts or stops the @ref traceRenderer following the backgroundRender
+   * parameter.
+   *
+   */
+  void updateRenderMode();
+
+  /**
+   * Get the width of the component in physical pixels of the monitor it is
+   * shown on.
+   *
+   * \return int Physical width, at least 2.
+   */
+  int getPhysicalWidth() const;
+
+  /**
+   * Resizes buffers when the displayed window or the pixel width changed
+   * since they were sized, so that one column is computed per physical pixel.
+   *
+   */
+  void updateLayout();
+
+  /**
+   * Recomputes the ratio and resizes every per-channel buffer to the current
+   * display length, window and capture geometry. Allocated storage is reused
+   * whenever it is large enough.
+   *
+   */
+  void resizeBuffers();
+
+  /**
+   * Pops every sample that arrived since the previous frame from the
+   * AudioBufferQueue and scrolls the complete columns into the displayed
+   * data. Samples a column still needs are kept for the next frame.
+   *
+   */
+  void renderFromSamples();
 
-  //==============================================================================
   /**
-   * Timer callback.
+   * Renders the whole displayed window from the SummaryPyramid.
    *
-   * @see <a href="https://docs.juce.com/master/classTimer.html">JUCE Timer </a>
+   */
+  void renderFromSummaries();
+
+  /**
+   * Consumes what the audio thread captured since the previous frame. Long
+   * windows are rendered from the SummaryPyramid, others from the samples of
+   * the AudioBufferQueue. Views that do not display a time window override it.
    *
    */
-  void timerCallback() override;
+  virtual void renderCapture();
 
   //==============================================================================
   /**
-   * Plots the waveform. This method is implemented in the subclasses in order to
-   * avoid having a check on the selected draw modality of the waveform every time
-   * it is plotted.
+   * Frame callback, called by the @ref scheduler.
+   *
+   * \param elapsedSeconds Seconds elapsed since the previous frame.
+   */
+  void frameCallback(double elapsedSeconds);
+
+  //==============================================================================
+  /**
+   * Rebuilds @ref traces from the displayed data. Called once per new data
+   * frame and on resize, never from paint.
+   *
+   * \param rect <a href="https://docs.juce.com/master/classRectangle.html">JUCE Rectangle </a>
+   * \param scaler Scale factor.
+   * \param offset Y-axis offset.
+   */
+  virtual void updateTraces(
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) = 0;
+
+  /**
+   * Splats the displayed data into the persistence buffer. Called once per
+   * new data frame in persistence mode, instead of @ref updateTraces.
+   *
+   * \param phosphor PhosphorBuffer to splat into.
+   * \param rect <a href="https://docs.juce.com/master/classRectangle.html">JUCE Rectangle </a>
+   * \param scaler Scale factor.
+   * \param offset Y-axis offset.
+   */
+  virtual void splat(
+      PhosphorBuffer &phosphor,
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) = 0;
+
+  /**
+   * Plots the waveform from the cached @ref traces. This method is implemented
+   * in the subclasses in order to avoid having a check on the selected draw
+   * modality of the waveform every time it is plotted.
    *
-   * \param data Samples to plot
-   * \param numSamples Number of samples
    * \param g <a href="https://docs.juce.com/master/classGraphics.html">JUCE Graphics </a>
    * \param rect <a href="https://docs.juce.com/master/classRectangle.html">JUCE Rectangle </a>
    * \param scaler Scale factor.
@@ -121,10 +296,42 @@ private:
       float offset = float(0)) = 0;
 
   /**
-   * This callback will be called in @ref timerCallback and is left
+   * Plots what is drawn on top of the traces, e.g. markers. Called by the
+   * subclasses' @ref plot and, in background render mode, on top of the
+   * image rendered by the @ref TraceRenderer.
+   *
+   * \param g <a href="https://docs.juce.com/master/classGraphics.html">JUCE Graphics </a>
+   * \param rect <a href="https://docs.juce.com/master/classRectangle.html">JUCE Rectangle </a>
+   * \param scaler Scale factor.
+   * \param offset Y-axis offset.
+   */
+  virtual void plotOverlay(
+      juce::Graphics &g,
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) {}
+
+  /**
+   * This callback will be called in @ref frameCallback and is left
    * to be implemented in the subclasses to handle subclass-specific
    * operations.
    *
+   * \param elapsedSeconds Seconds elapsed since the previous frame.
+   */
+  virtual void subclassSpecificCallback(double elapsedSeconds) = 0;
+
+  /**
+   * Called when the processor was reconfigured, before buffers are resized.
+   * Pointers into the previous capture buffers must be dropped here.
+   *
+   */
+  virtual void captureChanged() {}
+
+  /**
+   * Called after buffers were resized, e.g. because the pixel width or the
+   * displayed window changed. Data derived from the number of columns must be
+   * recomputed here.
+   *
    */
-  virtual void subclassSpecificCallback() = 0;
+  virtual void layoutChanged() {}
 };
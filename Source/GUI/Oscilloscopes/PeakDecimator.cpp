@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+    PeakDecimator.cpp
+    Created: 18 Oct 2026 10:14:32am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "PeakDecimator.h"
+
+void PeakDecimator::process(const float *input, int numSamples, float *minOutput, float *maxOutput, int numColumns)
+{
+  // nothing to reduce
+  if (numSamples <= 0 || numColumns <= 0)
+  {
+    return;
+  }
+
+  // reduce each column with a vectorised min/max scan
+  for (int column = 0; column < numColumns; ++column)
+  {
+    auto start = (int)((juce::int64)column * numSamples / numColumns);
+    auto end = (int)((juce::int64)(column + 1) * numSamples / numColumns);
+    end = juce::jlimit(start + 1, numSamples, end);
+
+    auto range = juce::FloatVectorOperations::findMinAndMax(input + start, end - start);
+    minOutput[column] = range.getStart();
+    maxOutput[column] = range.getEnd();
+  }
+}
@@ -0,0 +1,35 @@
+/*
+  ==============================================================================
+
+    PeakDecimator.h
+    Created: 18 Oct 2026 10:14:32am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Reduces raw samples to a min/max peak envelope, one pair per pixel column,
+ * so that no transient is lost when many samples fall into a single column.
+ *
+ */
+class PeakDecimator
+{
+public:
+  /**
+   * Reduces numSamples samples to numColumns min/max pairs.
+   *
+   * Column boundaries are spread evenly over the input. When there are fewer
+   * samples than columns each column holds the nearest sample.
+   *
+   * \param input Raw samples.
+   * \param numSamples Number of raw samples.
+   * \param minOutput Where to write the minimum of each column.
+   * \param maxOutput Where to write the maximum of each column.
+   * \param numColumns Number of columns to produce.
+   */
+  static void process(const float *input, int numSamples, float *minOutput, float *maxOutput, int numColumns);
+};
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    PhosphorBuffer.cpp
+    Created: 18 Oct 2026 5:02:13pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "PhosphorBuffer.h"
+
+PhosphorBuffer::PhosphorBuffer(juce::Colour colourToUse)
+{
+  // transparent to colour, then colour to white
+  for (int i = 0; i < lutSize; ++i)
+  {
+    auto t = float(i) / float(lutSize - 1);
+    auto colour = t < 0.5f
+                      ? colourToUse.withAlpha(std::sqrt(2.f * t))
+                      : colourToUse.interpolatedWith(juce::Colours::white, 2.f * t - 1.f);
+    lut[(size_t)i] = colour.getPixelARGB();
+  }
+}
+
+void PhosphorBuffer::setSize(int newWidth, int newHeight)
+{
+  // nothing changed
+  if (newWidth == width && newHeight == height)
+  {
+    return;
+  }
+
+  width = std::max(newWidth, 0);
+  height = std::max(newHeight, 0);
+  intensities.allocate((size_t)(width * height), true);
+  columnTop.resize((size_t)width);
+  columnBottom.resize((size_t)width);
+}
+
+void PhosphorBuffer::clear()
+{
+  juce::FloatVectorOperations::clear(intensities.get(), width * height);
+}
+
+void PhosphorBuffer::decay(float factor)
+{
+  juce::FloatVectorOperations::multiply(intensities.get(), factor, width * height);
+}
+
+void PhosphorBuffer::splatEnvelope(const float *mins, const float *maxs, size_t numColumns, juce::Rectangle<float> rect, float scaler, float offset, float intensity)
+{
+  // need at least two columns
+  if (numColumns < 2 || width == 0)
+  {
+    return;
+  }
+
+  // get bounds
+  auto center = rect.getBottom() - offset;
+  auto gain = rect.getHeight() * scaler;
+  auto columnsPerPixel = float(numColumns) / rect.getWidth();
+
+  // merge every column falling into each pixel, plus its neighbour so that the trace is continuous
+  for (int x = 0; x < width; ++x)
+  {
+    columnTop[x] = 1.f;
+    columnBottom[x] = 0.f;
+    auto start = (float(x) - rect.getX()) * columnsPerPixel;
+    auto end = start + columnsPerPixel;
+    if (end < 0.f || start > float(numColumns - 1))
+    {
+      continue;
+    }
+
+    auto first = (size_t)juce::jlimit(0, (int)numColumns - 1, (int)std::floor(start));
+    auto last = (size_t)juce::jlimit(0, (int)numColumns - 1, (int)std::ceil(end));
+    auto low = juce::FloatVectorOperations::findMinimum(mins + first, (int)(last - first + 1));
+    auto high = juce::FloatVectorOperations::findMaximum(maxs + first, (int)(last - first + 1));
+    columnTop[x] = center - gain * high;
+    columnBottom[x] = center - gain * low;
+  }
+
+  splatColumns(intensity);
+}
+
+void PhosphorBuffer::splatLine(const float *data, size_t numPoints, juce::Rectangle<float> rect, float scaler, float offset, float xShift, float intensity)
+{
+  // need at least two points
+  if (numPoints < 2 || width == 0)
+  {
+    return;
+  }
+
+  // get bounds
+  auto center = rect.getBottom() - offset;
+  auto gain = rect.getHeight() * scaler;
+  auto pointsPerPixel = float(numPoints) / rect.getWidth();
+  auto lastPoint = float(numPoints - 1);
+
+  // linear interpolation between samples
+  auto valueAt = [&](float position)
+  {
+    position = juce::jlimit(0.f, lastPoint, position);
+    auto index = std::min((size_t)position, numPoints - 2);
+    auto fraction = position - float(index);
+    return data[index] + fraction * (data[index + 1] - data[index]);
+  };
+
+  // span of the line over each pixel, samples inside it included
+  for (int x = 0; x < width; ++x)
+  {
+    columnTop[x] = 1.f;
+    columnBottom[x] = 0.f;
+    auto start = (float(x) - rect.getX()) * pointsPerPixel - xShift;
+    auto end = start + pointsPerPixel;
+    if (end < 0.f || start > lastPoint)
+    {
+      continue;
+    }
+
+    auto startValue = valueAt(start);
+    auto endValue = valueAt(end);
+    auto low = std::min(startValue, endValue);
+    auto high = std::max(startValue, endValue);
+    auto first = (int)std::ceil(std::max(start, 0.f));
+    auto last = (int)std::floor(std::min(end, lastPoint));
+    if (last >= first)
+    {
+      auto range = juce::FloatVectorOperations::findMinAndMax(data + first, last - first + 1);
+      low = std::min(low, range.getStart());
+      high = std::max(high, range.getEnd());
+    }
+    columnTop[x] = center - gain * high;
+    columnBottom[x] = center - gain * low;
+  }
+
+  splatColumns(intensity);
+}
+
+void PhosphorBuffer::splatPoints(const float *xs, const float *ys, size_t numPoints, juce::Rectangle<float> rect, float intensity)
+{
+  // get bounds
+  auto centreX = rect.getCentreX();
+  auto centreY = rect.getCentreY();
+  auto halfWidth = rect.getWidth() / 2.f;
+  auto halfHeight = rect.getHeight() / 2.f;
+
+  // one pixel per point, points out of the buffer, NaNs & infinities are
+  // dropped before the cast, which they would make undefined
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    auto fx = centreX + xs[i] * halfWidth;
+    auto fy = centreY - ys[i] * halfHeight;
+    if (!(fx >= 0.f && fx < float(width) && fy >= 0.f && fy < float(height)))
+    {
+      continue;
+    }
+    auto x = (size_t)fx;
+    auto y = (size_t)fy;
+    intensities[x * (size_t)height + y] += intensity;
+  }
+}
+
+void PhosphorBuffer::splatColumns(float intensity)
+{
+  for (int x = 0; x < width; ++x)
+  {
+    // skip empty columns, and NaN ones
+    if (!(columnTop[x] <= columnBottom[x]))
+    {
+      continue;
+    }
+
+    // add intensity over the span, at least one pixel, clamped before the cast
+    auto top = (int)std::floor(juce::jlimit(0.f, float(height - 1), columnTop[x]));
+    auto bottom = (int)std::floor(juce::jlimit(0.f, float(height - 1), columnBottom[x]));
+    auto length = bottom - top + 1;
+    juce::FloatVectorOperations::add(intensities.get() + (size_t)x * (size_t)height + (size_t)top, intensity / float(length), length);
+  }
+}
+
+void PhosphorBuffer::toneMap(juce::Image &image) const
+{
+  // reallocate on resize only
+  if (image.getWidth() != width || image.getHeight() != height)
+  {
+    image = juce::Image(juce::Image::ARGB, std::max(width, 1), std::max(height, 1), true);
+  }
+
+  // look up each pixel colour
+  auto scale = float(lutSize - 1) / saturationLevel;
+  juce::Image::BitmapData bitmap(image, juce::Image::BitmapData::writeOnly);
+  for (int x = 0; x < width; ++x)
+  {
+    auto column = intensities.get() + (size_t)x * (size_t)height;
+    for (int y = 0; y < height; ++y)
+    {
+      auto index = std::min(lutSize - 1, (int)(column[y] * scale));
+      *reinterpret_cast<juce::PixelARGB *>(bitmap.getPixelPointer(x, y)) = lut[(size_t)index];
+    }
+  }
+}
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    PhosphorBuffer.h
+    Created: 18 Oct 2026 5:02:13pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+/**
+ * Analog-style persistence buffer.
+ *
+ * Every trace is splatted into a float intensity buffer that decays
+ * exponentially each frame and is tone-mapped to colour through a lookup
+ * table. The buffer is stored column by column so that splatting a column and
+ * decaying the whole buffer are both contiguous vector operations.
+ *
+ */
+class PhosphorBuffer
+{
+public:
+  /**
+   * Construct a new Phosphor Buffer object.
+   *
+   * \param colourToUse Colour of medium intensities, dim ones fade to transparent
+   * and saturated ones to white.
+   */
+  PhosphorBuffer(juce::Colour colourToUse);
+
+  /**
+   * Resizes & clears the buffer if its size differs.
+   *
+   * \param newWidth Width in pixels.
+   * \param newHeight Height in pixels.
+   */
+  void setSize(int newWidth, int newHeight);
+
+  /**
+   * Clears the buffer.
+   *
+   */
+  void clear();
+
+  /**
+   * Multiplies every intensity by factor.
+   *
+   * \param factor Decay factor, between 0 and 1.
+   */
+  void decay(float factor);
+
+  /**
+   * Splats a min/max envelope of numColumns columns spread over rect.
+   *
+   * \param mins Minimum of each column.
+   * \param maxs Maximum of each column.
+   * \param numColumns Number of columns.
+   * \param rect <a href="https://docs.juce.com/master/classRectangle.html">JUCE Rectangle </a>
+   * \param scaler Scale factor.
+   * \param offset Y-axis offset.
+   * \param intensity Intensity added by each pixel column.
+   */
+  void splatEnvelope(const float *mins, const float *maxs, size_t numColumns, juce::Rectangle<float> rect, float scaler = float(1), float offset = float(0), float intensity = float(1));
+
+  /**
+   * Splats a line through numPoints samples spread over rect.
+   *
+   * \param data Samples.
+   * \param numPoints Number of samples.
+   * \param rect <a href="https://docs.juce.com/master/classRectangle.html">JUCE Rectangle </a>
+   * \param scaler Scale factor.
+   * \param offset Y-axis offset.
+   * \param xShift Shift of every point to the right, in samples.
+   * \param intensity Intensity added by each pixel column.
+   */
+  void splatLine(const float *data, size_t numPoints, juce::Rectangle<float> rect, float scaler = float(1), float offset = float(0), float xShift = float(0), float intensity = float(1));
+
+  /**
+   * Splats isolated points, such as the sample pairs of an XY display.
+   *
+   * \param xs Horizontal coordinate of each point, -1 and 1 at the left and right edges of rect.
+   * \param ys Vertical coordinate of each point, -1 and 1 at the bottom and top edges of rect.
+   * \param numPoints Number of points.
+   * \param rect <a href="https://docs.juce.com/master/classRectangle.html">JUCE Rectangle </a>
+   * \param intensity Intensity added by each point.
+   */
+  void splatPoints(const float *xs, const float *ys, size_t numPoints, juce::Rectangle<float> rect, float intensity = float(1));
+
+  /**
+   * Tone-maps the intensities into image, reallocating it if its size differs.
+   *
+   * \param image Image to write.
+   */
+  void toneMap(juce::Image &image) const;
+
+private:
+  static constexpr int lutSize = 256;            /**< Number of tone-mapping entries */
+  static constexpr float saturationLevel = 4.f;  /**< Intensity mapped to the last entry */
+
+  /**
+   * Adds intensity over the span [columnTop[x], columnBottom[x]] of each pixel
+   * column, spread so that long spans look dimmer like a fast beam.
+   *
+   * \param intensity Intensity added by each pixel column.
+   */
+  void splatColumns(float intensity);
+
+  int width = 0;                                  /**< Width in pixels */
+  int height = 0;                                 /**< Height in pixels */
+  juce::HeapBlock<float> intensities;             /**< Intensities, column by column */
+  std::vector<float> columnTop;                   /**< Top of each pixel column span, larger than columnBottom if empty */
+  std::vector<float> columnBottom;                /**< Bottom of each pixel column span */
+  std::array<juce::PixelARGB, lutSize> lut;       /**< Intensity to colour lookup table */
+};
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    RefreshScheduler.cpp
+    Created: 18 Oct 2026 10:12:36pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "RefreshScheduler.h"
+
+RefreshScheduler::RefreshScheduler(juce::Component &componentToSync, int maximumFramesPerSecond, std::function<void(double)> frameCallback)
+    : component(componentToSync),
+      callback(std::move(frameCallback)),
+      maximumRate(std::max(idleRate, double(maximumFramesPerSecond))),
+      budgetedRate(maximumRate),
+      vBlankAttachment(&componentToSync, [this]()
+                       { onVBlank(); })
+{
+}
+
+void RefreshScheduler::setMaximumRate(int maximumFramesPerSecond)
+{
+  maximumRate = std::max(idleRate, double(maximumFramesPerSecond));
+  budgetedRate = std::min(budgetedRate, maximumRate);
+}
+
+void RefreshScheduler::setWakeCheck(std::function<bool()> shouldWake)
+{
+  wakeCheck = std::move(shouldWake);
+}
+
+void RefreshScheduler::reportActivity(bool hasChanged)
+{
+  unchangedSeconds = hasChanged ? 0. : unchangedSeconds + lastElapsedSeconds;
+}
+
+double RefreshScheduler::getCurrentRate() const
+{
+  // slow down while nothing can be seen or nothing changes
+  if (!isVisibleOnScreen() || unchangedSeconds >= idleDelaySeconds)
+  {
+    return std::min(idleRate, budgetedRate);
+  }
+  return budgetedRate;
+}
+
+void RefreshScheduler::onVBlank()
+{
+  auto now = juce::Time::getMillisecondCounterHiRes();
+  if (lastFrameTime == 0.)
+  {
+    lastFrameTime = now;
+  }
+
+  // run on the first vertical blank close enough to the end of the interval, or when woken up
+  auto interval = 1000. / getCurrentRate();
+  auto elapsed = now - lastFrameTime;
+  if (elapsed < 0.9 * interval && elapsed > 0. && !(wakeCheck && wakeCheck()))
+  {
+    return;
+  }
+  lastFrameTime = now;
+  lastElapsedSeconds = elapsed / 1000.;
+  callback(lastElapsedSeconds);
+
+  // lower the rate while frames exceed their budget, raise it back once they fit easily
+  auto cost = juce::Time::getMillisecondCounterHiRes() - now;
+  averageCost += costSmoothing * (cost - averageCost);
+  auto budget = cpuBudget * 1000. / budgetedRate;
+  if (averageCost > budget)
+  {
+    budgetedRate = std::max(idleRate, budgetedRate / rateStep);
+  }
+  else if (averageCost < 0.5 * budget)
+  {
+    budgetedRate = std::min(maximumRate, budgetedRate * rateStep);
+  }
+}
+
+bool RefreshScheduler::isVisibleOnScreen() const
+{
+  auto peer = component.getPeer();
+  return component.isShowing() && peer != nullptr && !peer->isMinimised();
+}
@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    RefreshScheduler.h
+    Created: 18 Oct 2026 10:12:36pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <functional>
+#include "../../InitVariables.h"
+
+/**
+ * Calls a frame callback in sync with the display's vertical blank, at an
+ * adaptive rate.
+ *
+ * Frames run at up to the maximum rate when the content changes and the
+ * callback fits in its CPU budget. The rate falls to the idle rate while the
+ * component is not showing or its content has not changed for a while, and
+ * is lowered step by step while the callback takes more than its budget.
+ *
+ */
+class RefreshScheduler
+{
+public:
+  /**
+   * Constructor. Frames start at once.
+   *
+   * \param componentToSync Component whose display drives the frames.
+   * \param maximumFramesPerSecond Highest frame rate.
+   * \param frameCallback Called once per frame with the seconds elapsed since the previous one.
+   */
+  RefreshScheduler(juce::Component &componentToSync, int maximumFramesPerSecond, std::function<void(double)> frameCallback);
+
+  /**
+   * Sets the highest frame rate.
+   *
+   * \param maximumFramesPerSecond Highest frame rate.
+   */
+  void setMaximumRate(int maximumFramesPerSecond);
+
+  /**
+   * Reports whether the last frame changed what is displayed. To be called
+   * from the frame callback.
+   *
+   * \param hasChanged Whether the frame changed the content.
+   */
+  void reportActivity(bool hasChanged);
+
+  /**
+   * Sets a check run on every vertical blank between frames. A frame runs at
+   * once when it returns true, whatever the current rate.
+   *
+   * \param shouldWake Returns whether a frame is needed now. Must be cheap.
+   */
+  void setWakeCheck(std::function<bool()> shouldWake);
+
+  /**
+   * Get the current target frame rate.
+   *
+   * \return double Frames per second.
+   */
+  double getCurrentRate() const;
+
+private:
+  static constexpr double idleRate = EDITOR_IDLE_RATE(); /**< Frame rate when nothing changes or nothing is shown */
+  static constexpr double idleDelaySeconds = 0.5;        /**< Time without changes before falling to the idle rate */
+  static constexpr double cpuBudget = 0.25;              /**< Share of each frame interval the callback may take */
+  static constexpr double rateStep = 1.25;               /**< Factor the budgeted rate is lowered or raised by */
+  static constexpr double costSmoothing = 0.1;           /**< Weight of the latest callback duration in its average */
+
+  juce::Component &component;                            /**< Component whose display drives the frames */
+  std::function<void(double)> callback;                  /**< Frame callback */
+  std::function<bool()> wakeCheck;                       /**< Requests a frame before the interval elapsed */
+  double maximumRate;                                    /**< Highest frame rate */
+  double budgetedRate;                                   /**< Highest rate whose frames fit in the CPU budget */
+  double lastFrameTime = 0.;                             /**< Time of the last frame, in milliseconds */
+  double averageCost = 0.;                               /**< Average callback duration, in milliseconds */
+  double unchangedSeconds = 0.;                          /**< Time since the content last changed */
+  double lastElapsedSeconds = 0.;                        /**< Seconds elapsed before the last frame */
+  juce::VBlankAttachment vBlankAttachment;               /**< Vertical blank callbacks of the component's display */
+
+  /**
+   * Called on every vertical blank. Runs a frame if the current interval
+   * elapsed.
+   *
+   */
+  void onVBlank();
+
+  /**
+   * Returns whether the component is on a visible, non-minimised window.
+   *
+   * \return true if frames can be seen.
+   * \return false otherwise.
+   */
+  bool isVisibleOnScreen() const;
+};
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+    Spectrogram.cpp
+    Created: 19 Oct 2026 12:31:07am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "Spectrogram.h"
+#include <algorithm>
+#include <cmath>
+
+Spectrogram::Spectrogram(OscilloscopeAudioProcessor &aProcessor, int sampleRate)
+    : OscilloscopeComponent(aProcessor, sampleRate, aProcessor.getEditorRefreshRate())
+{
+  // black through purple and orange to pale yellow
+  const juce::Colour stops[] = {juce::Colours::black,
+                                juce::Colour(40, 0, 100),
+                                juce::Colour(190, 30, 80),
+                                juce::Colour(250, 150, 20),
+                                juce::Colour(255, 255, 200)};
+  auto numSegments = (int)std::size(stops) - 1;
+  for (int i = 0; i < lutSize; ++i)
+  {
+    auto position = float(i) / float(lutSize - 1) * float(numSegments);
+    auto segment = std::min(numSegments - 1, (int)position);
+    lut[(size_t)i] = stops[segment].interpolatedWith(stops[segment + 1], position - float(segment)).getPixelARGB();
+  }
+
+  // analyse the current geometry, keeping every spectrum
+  worker.reset(new SpectrumWorker(capture->geometry.numChannels, capture->geometry.sampleRate, historyFrames));
+}
+
+void Spectrogram::drawGrid(juce::Graphics &g, float w, float h)
+{
+  // drawn over the image by plotOverlay
+}
+
+void Spectrogram::renderCapture()
+{
+  // analysis of this frame
+  auto averaging = SpectrumWorker::getAveragingSeconds(parameters.spectrumAveraging);
+  worker->setAnalysis(SpectrumWorker::minOrder + parameters.fftSize, (SpectrumWorker::Window)parameters.fftWindow, averaging);
+
+  // hand the samples over, and the silence a quiet input no longer queues,
+  // so that floor-level columns keep scrolling at the hop rate
+  updateImageSize();
+  worker->pull(capture->buffers->queue);
+  worker->pullSilence(capture->buffers->collector.getActivity());
+
+  // one column per new spectrum, only the most recent ones fit
+  auto numWritten = worker->popFrames(image.getWidth(), [this](const float *bands)
+                                      { writeSpectrum(bands); });
+  if (numWritten > 0)
+  {
+    tracesNeedUpdate = true;
+  }
+}
+
+void Spectrogram::captureChanged()
+{
+  // history of the previous geometry is meaningless
+  worker.reset(new SpectrumWorker(capture->geometry.numChannels, capture->geometry.sampleRate, historyFrames));
+  image = juce::Image();
+}
+
+void Spectrogram::updateImageSize()
+{
+  auto width = std::max(1, getWidth());
+  auto height = std::max(1, getHeight());
+  if (image.isValid() && image.getWidth() == width && image.getHeight() == height)
+  {
+    return;
+  }
+
+  // unroll the history into the new size, oldest column on the left
+  juce::Image resized(juce::Image::ARGB, width, height, true);
+  {
+    juce::Graphics g(resized);
+    g.fillAll(juce::Colours::black);
+    if (image.isValid())
+    {
+      auto oldWidth = image.getWidth();
+      auto split = juce::roundToInt(float(oldWidth - writeColumn) * float(width) / float(oldWidth));
+      g.drawImage(image, 0, 0, split, height, writeColumn, 0, oldWidth - writeColumn, image.getHeight());
+      g.drawImage(image, split, 0, width - split, height, 0, 0, writeColumn, image.getHeight());
+    }
+  }
+  image = resized;
+  writeColumn = 0;
+  rowLevels.resize((size_t)height);
+  tracesNeedUpdate = true;
+}
+
+void Spectrogram::writeSpectrum(const float *bands)
+{
+  // peak of the bands each row covers, Nyquist at the top
+  auto height = image.getHeight();
+  for (int row = 0; row < height; ++row)
+  {
+    auto fromBottom = height - 1 - row;
+    auto first = (int)((juce::int64)fromBottom * SpectrumWorker::numBands / height);
+    auto end = std::max(first + 1, (int)((juce::int64)(fromBottom + 1) * SpectrumWorker::numBands / height));
+    rowLevels[(size_t)row] = *std::max_element(bands + first, bands + end);
+  }
+
+  // levels to colour indices in one vectorised pass
+  auto levels = rowLevels.data();
+  juce::FloatVectorOperations::add(levels, rangeDecibels - topDecibels, height);
+  juce::FloatVectorOperations::multiply(levels, float(lutSize - 1) / rangeDecibels, height);
+  juce::FloatVectorOperations::clip(levels, levels, 0.f, float(lutSize - 1), height);
+
+  // write the oldest column only
+  juce::Image::BitmapData bitmap(image, writeColumn, 0, 1, height, juce::Image::BitmapData::writeOnly);
+  for (int row = 0; row < height; ++row)
+  {
+    *reinterpret_cast<juce::PixelARGB *>(bitmap.getPixelPointer(0, row)) = lut[(size_t)levels[row]];
+  }
+  writeColumn = (writeColumn + 1) % image.getWidth();
+}
+
+void Spectrogram::updateTraces(juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // Nothing to do, columns are written as spectra arrive
+  return;
+}
+
+void Spectrogram::splat(PhosphorBuffer &phosphor, juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // Never called, the spectrogram has no persistence
+  return;
+}
+
+void Spectrogram::plot(juce::Graphics &g, juce::Rectangle<float> rect, float scaler, float offset)
+{
+  if (image.isValid())
+  {
+    // oldest columns on the left, newest on the right
+    auto width = image.getWidth();
+    auto height = image.getHeight();
+    g.drawImage(image, 0, 0, width - writeColumn, height, writeColumn, 0, width - writeColumn, height);
+    if (writeColumn > 0)
+    {
+      g.drawImage(image, width - writeColumn, 0, writeColumn, height, 0, 0, writeColumn, height);
+    }
+  }
+
+  plotOverlay(g, rect, scaler, offset);
+}
+
+void Spectrogram::plotOverlay(juce::Graphics &g, juce::Rectangle<float> rect, float scaler, float offset)
+{
+  if (!parameters.drawGrid)
+  {
+    return;
+  }
+
+  // set graphics parameters
+  g.setColour(juce::Colours::ghostwhite);
+  g.setOpacity(0.4);
+
+  // frequency lines on the log scale of the bands
+  auto nyquist = capture->geometry.sampleRate / 2.;
+  auto span = std::log(nyquist / SpectrumWorker::minFrequency);
+  auto w = rect.getWidth();
+  auto h = rect.getHeight();
+  for (auto frequency : {50., 100., 200., 500., 1000., 2000., 5000., 10000., 20000.})
+  {
+    if (frequency >= nyquist)
+    {
+      break;
+    }
+    auto y = float(h * (1. - std::log(frequency / SpectrumWorker::minFrequency) / span));
+    auto text = frequency < 1000. ? juce::String((int)frequency) : juce::String((int)(frequency / 1000.)) + "k";
+    g.drawLine(0, y, w, y);
+    g.drawSingleLineText(text, 4, (int)y - 2);
+  }
+}
+
+void Spectrogram::subclassSpecificCallback(double elapsedSeconds)
+{
+  // Nothing to do for this subclass
+  return;
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    Spectrogram.h
+    Created: 19 Oct 2026 12:31:07am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "OscilloscopeComponent.h"
+#include "SpectrumWorker.h"
+
+/**
+ * Scrolling spectrogram. Each spectrum computed by a @ref SpectrumWorker
+ * becomes one pixel column of a circular image, the newest on the right,
+ * frequency rising upwards on a log scale.
+ *
+ * A frame writes its new columns only, through a colour lookup table, and
+ * paint draws the circular image as two blits. The cost of a frame depends on
+ * the number of new columns, never on the history shown.
+ */
+class Spectrogram : public OscilloscopeComponent
+{
+public:
+  /**
+   * Construct a new Spectrogram object
+   *
+   * \param aProcessor PluginProcessor audio processor.
+   * \param sampleRate Sample rate of the host.
+   */
+  Spectrogram(OscilloscopeAudioProcessor &aProcessor, int sampleRate);
+
+  /**
+   * Does nothing, the opaque image would hide the grid. Frequency lines are
+   * drawn over it by @ref plotOverlay instead.
+   *
+   * \param g <a href="https://docs.juce.com/master/classGraphics.html">JUCE Graphics </a>.
+   * \param w width.
+   * \param h heigth.
+   */
+  void drawGrid(juce::Graphics &g, float w, float h) override;
+
+private:
+  static constexpr int lutSize = 256;              /**< Number of colour entries */
+  static constexpr int historyFrames = 256;        /**< Spectra the worker keeps between two frames */
+  static constexpr float topDecibels = 0.f;        /**< Level mapped to the last colour */
+  static constexpr float rangeDecibels = 120.f;    /**< Levels between the first and last colours */
+
+  std::unique_ptr<SpectrumWorker> worker;          /**< Computes spectra off the message thread */
+  juce::Image image;                               /**< Circular image, one column per spectrum */
+  int writeColumn = 0;                             /**< Column the next spectrum is written to, i.e. the oldest one */
+  std::vector<float> rowLevels;                    /**< Level, then colour index, of each row of a new column */
+  std::array<juce::PixelARGB, lutSize> lut;        /**< Level to colour lookup table */
+
+  /**
+   * Hands the captured samples to the worker and writes one column per new
+   * spectrum.
+   *
+   */
+  void renderCapture() override;
+
+  /**
+   * Restarts the worker and clears the history at the new geometry.
+   *
+   */
+  void captureChanged() override;
+
+  /**
+   * Follows the component size. The history is kept, stretched to the new
+   * size.
+   *
+   */
+  void updateImageSize();
+
+  /**
+   * Writes a spectrum into the oldest column and makes it the newest.
+   *
+   * \param bands numBands levels in decibels.
+   */
+  void writeSpectrum(const float *bands);
+
+  bool drawsTraces() const override { return false; }
+
+  void updateTraces(
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  void splat(
+      PhosphorBuffer &phosphor,
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  void plot(
+      juce::Graphics &g,
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  void plotOverlay(
+      juce::Graphics &g,
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  void subclassSpecificCallback(double elapsedSeconds) override;
+};
@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.cpp
+    Created: 18 Oct 2026 11:48:19pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyser.h"
+#include <algorithm>
+#include <cmath>
+
+SpectrumAnalyser::SpectrumAnalyser(OscilloscopeAudioProcessor &aProcessor, int sampleRate)
+    : OscilloscopeComponent(aProcessor, sampleRate, aProcessor.getEditorRefreshRate())
+{
+  // analyse the current geometry
+  worker.reset(new SpectrumWorker(capture->geometry.numChannels, capture->geometry.sampleRate));
+}
+
+void SpectrumAnalyser::drawGrid(juce::Graphics &g, float w, float h)
+{
+  // set graphics parameters
+  g.setColour(juce::Colours::ghostwhite);
+  g.setOpacity(0.4);
+
+  // frequency lines on the log scale of the bands
+  auto nyquist = capture->geometry.sampleRate / 2.;
+  auto span = std::log(nyquist / SpectrumWorker::minFrequency);
+  for (auto frequency : {50., 100., 200., 500., 1000., 2000., 5000., 10000., 20000.})
+  {
+    if (frequency >= nyquist)
+    {
+      break;
+    }
+    auto x = float(w * std::log(frequency / SpectrumWorker::minFrequency) / span);
+    auto text = frequency < 1000. ? juce::String((int)frequency) : juce::String((int)(frequency / 1000.)) + "k";
+    g.drawLine(x, 0, x, h);
+    g.drawSingleLineText(text, (int)x + 2, (int)h - 4);
+  }
+
+  // level lines every 20 dB
+  for (auto level = topDecibels - 20.f; level > topDecibels - rangeDecibels; level -= 20.f)
+  {
+    auto y = h * (topDecibels - level) / rangeDecibels;
+    g.drawLine(0, y, w, y);
+    g.drawSingleLineText(juce::String((int)level) + " dB", 4, (int)y - 2);
+  }
+}
+
+void SpectrumAnalyser::renderCapture()
+{
+  // analysis of this frame
+  auto averaging = SpectrumWorker::getAveragingSeconds(parameters.spectrumAveraging);
+  worker->setAnalysis(SpectrumWorker::minOrder + parameters.fftSize, (SpectrumWorker::Window)parameters.fftWindow, averaging);
+
+  // hand the samples over, and the silence a quiet input no longer queues,
+  // so that the average decays instead of freezing; display the latest spectrum
+  worker->pull(capture->buffers->queue);
+  worker->pullSilence(capture->buffers->collector.getActivity());
+  if (auto bands = worker->acquireLatest())
+  {
+    latestBands = bands;
+    reduceToColumns();
+  }
+}
+
+void SpectrumAnalyser::captureChanged()
+{
+  // spectra of the previous geometry are meaningless
+  latestBands = nullptr;
+  columns.clear();
+  worker.reset(new SpectrumWorker(capture->geometry.numChannels, capture->geometry.sampleRate));
+}
+
+void SpectrumAnalyser::layoutChanged()
+{
+  // follow the new width
+  if (latestBands != nullptr)
+  {
+    reduceToColumns();
+  }
+}
+
+void SpectrumAnalyser::reduceToColumns()
+{
+  auto numColumns = getNumColumns();
+  columns.resize((size_t)numChannels);
+  for (int channel = 0; channel < numChannels; ++channel)
+  {
+    auto &levels = columns[(size_t)channel];
+    auto bands = latestBands + (size_t)channel * SpectrumWorker::numBands;
+    levels.resize((size_t)numColumns);
+    for (int column = 0; column < numColumns; ++column)
+    {
+      // peak of the bands the column covers, at least one
+      auto first = (int)((juce::int64)column * SpectrumWorker::numBands / numColumns);
+      auto end = std::max(first + 1, (int)((juce::int64)(column + 1) * SpectrumWorker::numBands / numColumns));
+      auto level = *std::max_element(bands + first, bands + end);
+
+      // top level at the top edge, bottom level at the bottom edge
+      levels[(size_t)column] = juce::jlimit(-0.5f, 0.5f, (level - topDecibels) / rangeDecibels + 0.5f);
+    }
+  }
+  tracesNeedUpdate = true;
+}
+
+void SpectrumAnalyser::updateTraces(juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // one line per channel, nothing before the first spectrum
+  for (size_t channel = 0; channel < traces.size(); ++channel)
+  {
+    if (channel < columns.size())
+    {
+      traces[channel].updateLine(columns[channel].data(), columns[channel].size(), rect, scaler, offset);
+    }
+    else
+    {
+      traces[channel].clear();
+    }
+  }
+}
+
+void SpectrumAnalyser::splat(PhosphorBuffer &phosphor, juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // line of every channel
+  for (auto &levels : columns)
+  {
+    phosphor.splatLine(levels.data(), levels.size(), rect, scaler, offset);
+  }
+}
+
+void SpectrumAnalyser::plot(juce::Graphics &g, juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // draw cached lines
+  for (size_t channel = 0; channel < traces.size(); ++channel)
+  {
+    g.setColour(CHANNELCOLOUR((int)channel));
+    traces[channel].draw(g);
+  }
+}
+
+void SpectrumAnalyser::subclassSpecificCallback(double elapsedSeconds)
+{
+  // Nothing to do for this subclass
+  return;
+}
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.h
+    Created: 18 Oct 2026 11:48:19pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "OscilloscopeComponent.h"
+#include "SpectrumWorker.h"
+#include "../../GUI/ColorPalette.h"
+
+/**
+ * Spectrum analyser. Displays the averaged magnitude spectrum of each channel
+ * on a log-frequency axis.
+ *
+ * Samples of the capture queue are analysed by a @ref SpectrumWorker. Each
+ * frame only reduces its fixed number of bands to the displayed columns, so
+ * the message thread cost does not depend on the FFT size.
+ */
+class SpectrumAnalyser : public OscilloscopeComponent
+{
+public:
+  /**
+   * Construct a new Spectrum Analyser object
+   *
+   * \param aProcessor PluginProcessor audio processor.
+   * \param sampleRate Sample rate of the host.
+   */
+  SpectrumAnalyser(OscilloscopeAudioProcessor &aProcessor, int sampleRate);
+
+  /**
+   * Draws the frequency and level grid.
+   *
+   * \param g <a href="https://docs.juce.com/master/classGraphics.html">JUCE Graphics </a>.
+   * \param w width.
+   * \param h heigth.
+   */
+  void drawGrid(juce::Graphics &g, float w, float h) override;
+
+private:
+  static constexpr float topDecibels = 0.f;     /**< Level at the top edge */
+  static constexpr float rangeDecibels = 120.f; /**< Levels between the top and bottom edges */
+
+  std::unique_ptr<SpectrumWorker> worker;    /**< Computes spectra off the message thread */
+  const float *latestBands = nullptr;        /**< Bands of the latest spectrum, valid until the next acquire */
+  std::vector<std::vector<float>> columns;   /**< Displayed level of each column, per channel */
+
+  /**
+   * Hands the captured samples to the worker and reduces its latest spectrum,
+   * if any, to the displayed columns.
+   *
+   */
+  void renderCapture() override;
+
+  /**
+   * Restarts the worker at the new geometry.
+   *
+   */
+  void captureChanged() override;
+
+  /**
+   * Reduces the latest spectrum to the new number of columns.
+   *
+   */
+  void layoutChanged() override;
+
+  /**
+   * Reduces the latest spectrum to one level per column, the peak of the bands
+   * it covers. Bands and columns span the same log-frequency scale, so every
+   * column covers a fixed range of bands.
+   *
+   */
+  void reduceToColumns();
+
+  void updateTraces(
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  void splat(
+      PhosphorBuffer &phosphor,
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  void plot(
+      juce::Graphics &g,
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  void subclassSpecificCallback(double elapsedSeconds) override;
+};
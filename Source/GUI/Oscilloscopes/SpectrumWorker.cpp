@@ -0,0 +1,350 @@
+/*
+  ==============================================================================
+
+    SpectrumWorker.cpp
+    Created: 18 Oct 2026 11:48:19pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "SpectrumWorker.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+SpectrumWorker::SpectrumWorker(int numChannels, double sampleRate, int numHistoryFrames)
+    : juce::Thread("Oscilloscope Spectrum"),
+      numChannels(numChannels),
+      sampleRate(sampleRate),
+      historyFifo(std::max(1, numHistoryFrames + 1))
+{
+  // fifo and bands never reallocate
+  fifoData.resize((size_t)numChannels);
+  for (auto &channel : fifoData)
+  {
+    channel.resize((size_t)fifoLength);
+  }
+  fifoPointers.resize((size_t)numChannels);
+  for (auto &spectrum : spectra)
+  {
+    spectrum.assign((size_t)numChannels * numBands, 0.f);
+  }
+  historyData.resize((size_t)historyFifo.getTotalSize() * numBands);
+  frameBands.resize(numHistoryFrames > 0 ? (size_t)numChannels * numBands : 0);
+
+  startThread();
+}
+
+SpectrumWorker::~SpectrumWorker()
+{
+  // wake the thread up so that it can exit
+  signalThreadShouldExit();
+  notify();
+  stopThread(1000);
+}
+
+void SpectrumWorker::setAnalysis(int newOrder, Window newWindow, float averagingSeconds)
+{
+  // wake the worker up only on a change
+  auto changed = requestedOrder.exchange(newOrder, std::memory_order_relaxed) != newOrder;
+  changed = requestedWindow.exchange((int)newWindow, std::memory_order_relaxed) != (int)newWindow || changed;
+  changed = requestedAveraging.exchange(averagingSeconds, std::memory_order_relaxed) != averagingSeconds || changed;
+  if (changed)
+  {
+    notify();
+  }
+}
+
+void SpectrumWorker::pull(AudioBufferQueue<float> &queue)
+{
+  jassert(queue.getNumChannels() == numChannels);
+
+  // as many samples as the fifo can take
+  auto numToPull = (int)std::min(queue.getNumReady(), (size_t)fifo.getFreeSpace());
+  if (numToPull <= 0)
+  {
+    return;
+  }
+
+  // pop straight into the fifo, at most two spans
+  int start1, size1, start2, size2;
+  fifo.prepareToWrite(numToPull, start1, size1, start2, size2);
+  for (int channel = 0; channel < numChannels; ++channel)
+  {
+    fifoPointers[(size_t)channel] = fifoData[(size_t)channel].data() + start1;
+  }
+  auto numPulled = queue.pop(fifoPointers.data(), (size_t)size1);
+  if (size2 > 0)
+  {
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+      fifoPointers[(size_t)channel] = fifoData[(size_t)channel].data() + start2;
+    }
+    numPulled += queue.pop(fifoPointers.data(), (size_t)size2);
+  }
+
+  // publish & wake worker up
+  fifo.finishedWrite((int)numPulled);
+  notify();
+}
+
+void SpectrumWorker::pullSilence(const ActivityDetector<float> &activity)
+{
+  // quiet samples not moved yet, the count restarts when the input wakes up
+  auto numQuiet = activity.getNumQuietSamples();
+  if (numQuiet < numQuietSamplesPulled)
+  {
+    numQuietSamplesPulled = 0;
+  }
+  auto numToPull = (int)std::min(numQuiet - numQuietSamplesPulled, (juce::uint64)fifo.getFreeSpace());
+  if (numToPull <= 0)
+  {
+    return;
+  }
+
+  // zeros into the fifo, at most two spans
+  int start1, size1, start2, size2;
+  fifo.prepareToWrite(numToPull, start1, size1, start2, size2);
+  for (int channel = 0; channel < numChannels; ++channel)
+  {
+    juce::FloatVectorOperations::clear(fifoData[(size_t)channel].data() + start1, size1);
+    juce::FloatVectorOperations::clear(fifoData[(size_t)channel].data() + start2, size2);
+  }
+
+  // publish & wake worker up
+  fifo.finishedWrite(size1 + size2);
+  numQuietSamplesPulled += (juce::uint64)(size1 + size2);
+  notify();
+}
+
+const float *SpectrumWorker::acquireLatest()
+{
+  // swap only if something new was computed
+  if (!(latestSpectrum.load(std::memory_order_acquire) & newFlag))
+  {
+    return nullptr;
+  }
+  spectrumReadIndex = latestSpectrum.exchange(spectrumReadIndex, std::memory_order_acq_rel) & indexMask;
+  return spectra[(size_t)spectrumReadIndex].data();
+}
+
+int SpectrumWorker::popFrames(int maxFrames, const std::function<void(const float *)> &consumer)
+{
+  // skip frames that would be overwritten at once
+  auto numReady = historyFifo.getNumReady();
+  if (numReady > maxFrames)
+  {
+    historyFifo.finishedRead(numReady - maxFrames);
+    numReady = maxFrames;
+  }
+
+  // oldest first, at most two spans
+  int start1, size1, start2, size2;
+  historyFifo.prepareToRead(numReady, start1, size1, start2, size2);
+  for (int frame = 0; frame < size1; ++frame)
+  {
+    consumer(historyData.data() + (size_t)(start1 + frame) * numBands);
+  }
+  for (int frame = 0; frame < size2; ++frame)
+  {
+    consumer(historyData.data() + (size_t)(start2 + frame) * numBands);
+  }
+  historyFifo.finishedRead(size1 + size2);
+  return size1 + size2;
+}
+
+float SpectrumWorker::getAveragingSeconds(int choice)
+{
+  static constexpr float times[] = {0.f, 0.1f, 0.5f, 2.f};
+  return times[juce::jlimit(0, (int)std::size(times) - 1, choice)];
+}
+
+double SpectrumWorker::getFrequency(double sampleRate, double proportion)
+{
+  // geometric scale from the lowest band to Nyquist
+  return minFrequency * std::pow(sampleRate / 2. / minFrequency, proportion);
+}
+
+void SpectrumWorker::run()
+{
+  while (!threadShouldExit())
+  {
+    // sleep until samples or settings arrive
+    wait(-1);
+    applyAnalysis();
+
+    // analyse & publish, frames kept in the history are published one by one
+    if (analyseReady() && frameBands.empty())
+    {
+      reduceToBands(spectra[(size_t)spectrumWriteIndex].data());
+      spectrumWriteIndex = latestSpectrum.exchange(spectrumWriteIndex | newFlag, std::memory_order_acq_rel) & indexMask;
+    }
+  }
+}
+
+void SpectrumWorker::applyAnalysis()
+{
+  auto newOrder = juce::jlimit(minOrder, maxOrder, requestedOrder.load(std::memory_order_relaxed));
+  auto newWindow = requestedWindow.load(std::memory_order_relaxed);
+  if (newOrder != order || newWindow != window)
+  {
+    order = newOrder;
+    window = newWindow;
+    fftSize = 1 << order;
+    hop = fftSize / overlap;
+    fft.reset(new juce::dsp::FFT(order));
+
+    // periodic window: one point more than the frame, last one dropped
+    using Windowing = juce::dsp::WindowingFunction<float>;
+    auto method = (Window)window == Window::flatTop          ? Windowing::flatTop
+                  : (Window)window == Window::blackmanHarris ? Windowing::blackmanHarris
+                                                             : Windowing::hann;
+    windowTable.resize((size_t)fftSize + 1);
+    Windowing::fillWindowingTables(windowTable.data(), windowTable.size(), method, false);
+    windowTable.resize((size_t)fftSize);
+
+    // a full-scale sine reads 0 dB whatever the window
+    auto windowSum = std::accumulate(windowTable.begin(), windowTable.end(), 0.);
+    powerScale = float(4. / (windowSum * windowSum));
+
+    // restart from empty frames
+    fftData.assign(2 * (size_t)fftSize, 0.f);
+    frames.assign((size_t)numChannels, std::vector<float>((size_t)fftSize, 0.f));
+    averages.assign((size_t)numChannels, std::vector<float>((size_t)fftSize / 2 + 1, 0.f));
+    numSinceFrame = 0;
+    numValid = 0;
+
+    // bins between the edges of each band
+    auto binsPerHz = fftSize / sampleRate;
+    auto lastBin = fftSize / 2;
+    bands.resize(numBands);
+    for (int band = 0; band < numBands; ++band)
+    {
+      auto low = getFrequency(sampleRate, double(band) / numBands) * binsPerHz;
+      auto high = getFrequency(sampleRate, double(band + 1) / numBands) * binsPerHz;
+      bands[(size_t)band].firstBin = std::min(lastBin, (int)std::ceil(low));
+      bands[(size_t)band].lastBin = std::min(lastBin, (int)std::ceil(high) - 1);
+      bands[(size_t)band].centreBin = float(std::sqrt(low * high));
+    }
+  }
+
+  // averaging time constant, counted in frames
+  auto averagingSeconds = requestedAveraging.load(std::memory_order_relaxed);
+  smoothing = averagingSeconds > 0.f ? float(1. - std::exp(-hop / sampleRate / averagingSeconds)) : 1.f;
+}
+
+bool SpectrumWorker::analyseReady()
+{
+  // far behind, only the latest frame is worth analysing
+  auto numReady = fifo.getNumReady();
+  if (numReady > fifoLength / 2)
+  {
+    fifo.finishedRead(numReady - fftSize);
+    numReady = fftSize;
+    numSinceFrame = 0;
+    numValid = 0;
+  }
+
+  auto analysed = false;
+  while (numReady > 0)
+  {
+    // append up to the next frame
+    auto numToAppend = std::min(numReady, hop - numSinceFrame);
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numToAppend, start1, size1, start2, size2);
+    for (size_t channel = 0; channel < frames.size(); ++channel)
+    {
+      auto &frame = frames[channel];
+      auto source = fifoData[channel].data();
+      auto end = frame.end() - numToAppend;
+      std::copy(frame.begin() + numToAppend, frame.end(), frame.begin());
+      std::copy(source + start1, source + start1 + size1, end);
+      std::copy(source + start2, source + start2 + size2, end + size1);
+    }
+    fifo.finishedRead(size1 + size2);
+    numReady -= numToAppend;
+    numSinceFrame += numToAppend;
+    numValid = std::min(fftSize, numValid + numToAppend);
+
+    // frames are analysed once they hold nothing but contiguous samples
+    if (numSinceFrame == hop)
+    {
+      numSinceFrame = 0;
+      if (numValid == fftSize)
+      {
+        analyseFrame();
+        pushToHistory();
+        analysed = true;
+      }
+    }
+  }
+  return analysed;
+}
+
+void SpectrumWorker::analyseFrame()
+{
+  auto numBins = fftSize / 2 + 1;
+  for (size_t channel = 0; channel < frames.size(); ++channel)
+  {
+    // window & transform
+    juce::FloatVectorOperations::multiply(fftData.data(), frames[channel].data(), windowTable.data(), fftSize);
+    fft->performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    // exponential average of the power
+    auto average = averages[channel].data();
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+      auto power = fftData[(size_t)bin] * fftData[(size_t)bin] * powerScale;
+      average[bin] += smoothing * (power - average[bin]);
+    }
+  }
+}
+
+void SpectrumWorker::reduceToBands(float *output) const
+{
+  auto lastBin = fftSize / 2;
+  for (size_t channel = 0; channel < averages.size(); ++channel)
+  {
+    auto average = averages[channel].data();
+    auto channelOutput = output + channel * numBands;
+    for (size_t band = 0; band < bands.size(); ++band)
+    {
+      // peak of the bins inside the band, or interpolated between the nearest two
+      auto &range = bands[band];
+      float power;
+      if (range.lastBin >= range.firstBin)
+      {
+        power = *std::max_element(average + range.firstBin, average + range.lastBin + 1);
+      }
+      else
+      {
+        auto index = std::min(lastBin - 1, (int)range.centreBin);
+        auto fraction = range.centreBin - float(index);
+        power = average[index] + fraction * (average[index + 1] - average[index]);
+      }
+      channelOutput[band] = 10.f * std::log10(std::max(power, 1.0e-20f));
+    }
+  }
+}
+
+void SpectrumWorker::pushToHistory()
+{
+  // no history kept, or the message thread is late
+  if (frameBands.empty() || historyFifo.getFreeSpace() < 1)
+  {
+    return;
+  }
+
+  // loudest channel of each band
+  int start1, size1, start2, size2;
+  historyFifo.prepareToWrite(1, start1, size1, start2, size2);
+  auto frame = historyData.data() + (size_t)start1 * numBands;
+  reduceToBands(frameBands.data());
+  std::copy(frameBands.begin(), frameBands.begin() + numBands, frame);
+  for (int channel = 1; channel < numChannels; ++channel)
+  {
+    juce::FloatVectorOperations::max(frame, frame, frameBands.data() + (size_t)channel * numBands, numBands);
+  }
+  historyFifo.finishedWrite(1);
+}
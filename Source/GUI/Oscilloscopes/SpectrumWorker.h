@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+
+    SpectrumWorker.h
+    Created: 18 Oct 2026 11:48:19pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "../../Buffers/ActivityDetector.h"
+#include "../../Buffers/AudioBufferQueue.h"
+
+/**
+ * Worker thread computing averaged magnitude spectra of the captured signal,
+ * off the message thread.
+ *
+ * The message thread moves the samples it pops from the capture queue into a
+ * lock-free fifo. The worker cuts them into windowed frames overlapping by
+ * 75 %, transforms them with juce::dsp::FFT, averages their power over time
+ * and reduces each spectrum to a fixed number of log-spaced bands, from
+ * minFrequency to Nyquist. Bands are handed back through a lock-free triple
+ * buffer, so the cost of displaying a spectrum does not depend on the FFT size.
+ *
+ * Inherits from <a href="https://docs.juce.com/master/classThread.html">JUCE Thread</a>
+ */
+class SpectrumWorker : private juce::Thread
+{
+public:
+  /**
+   * Windows applied to each frame.
+   */
+  enum class Window
+  {
+    hann,           /**< Good frequency resolution, moderate leakage */
+    blackmanHarris, /**< Low leakage, wider peaks */
+    flatTop         /**< Accurate peak amplitudes, widest peaks */
+  };
+
+  static constexpr int minOrder = 10;           /**< Order of the smallest FFT, 1024 points */
+  static constexpr int maxOrder = 16;           /**< Order of the largest FFT, 65536 points */
+  static constexpr int overlap = 4;             /**< Frames per FFT length */
+  static constexpr int numBands = 4096;         /**< Log-spaced bands per channel, more than any display has pixels */
+  static constexpr double minFrequency = 20.;   /**< Frequency of the lowest band */
+
+  /**
+   * Construct a new Spectrum Worker object and starts its thread.
+   *
+   * \param numChannels Number of analysed channels.
+   * \param sampleRate Sample rate of the analysed signal.
+   * \param numHistoryFrames Frames kept for @ref popFrames, 0 when only the
+   * latest spectrum is needed.
+   */
+  SpectrumWorker(int numChannels, double sampleRate, int numHistoryFrames = 0);
+
+  /**
+   * Stops the thread and destroys the Spectrum Worker object.
+   *
+   */
+  ~SpectrumWorker() override;
+
+  /**
+   * Sets the analysis. To be called from the message thread only. Changing the
+   * FFT size or the window restarts the analysis.
+   *
+   * \param order FFT order, between minOrder and maxOrder.
+   * \param window Window applied to each frame.
+   * \param averagingSeconds Time constant of the power average, 0 for none.
+   */
+  void setAnalysis(int order, Window window, float averagingSeconds);
+
+  /**
+   * Moves every sample ready in a queue to the worker and wakes it up. To be
+   * called from the message thread only. Samples that do not fit in the fifo
+   * stay in the queue.
+   *
+   * \param queue Queue to pop, with as many channels as the worker.
+   */
+  void pull(AudioBufferQueue<float> &queue);
+
+  /**
+   * Moves to the worker the silence a quiet input kept out of the capture
+   * queue since the previous call, so that the analysis goes on at the rate
+   * of the input. To be called from the message thread only, after
+   * @ref pull. Silence that does not fit in the fifo is moved by later calls.
+   *
+   * \param activity Silence state of the collector filling the queue.
+   */
+  void pullSilence(const ActivityDetector<float> &activity);
+
+  /**
+   * Acquires the bands of the most recent spectrum. To be called from the
+   * message thread only, on a worker constructed without history frames. The
+   * bands stay untouched until the next call.
+   *
+   * \return const float* numBands levels in decibels per channel, channel after
+   * channel, nullptr if nothing was computed since the previous call.
+   */
+  const float *acquireLatest();
+
+  /**
+   * Passes the bands of every frame computed since the previous call to a
+   * consumer, oldest first, then frees them. To be called from the message
+   * thread only, on a worker constructed with history frames. Each band holds
+   * the loudest channel.
+   *
+   * \param maxFrames Most recent frames to pass, older ones are skipped.
+   * \param consumer Called with numBands levels in decibels per frame.
+   * \return int Number of frames passed.
+   */
+  int popFrames(int maxFrames, const std::function<void(const float *)> &consumer);
+
+  /**
+   * Get the averaging time constant of a spectrumAveraging choice.
+   *
+   * \param choice Index of the choice, from none to slow.
+   * \return float Time constant in seconds, 0 for none.
+   */
+  static float getAveragingSeconds(int choice);
+
+  /**
+   * Get the frequency at a position of the band scale.
+   *
+   * \param sampleRate Sample rate of the analysed signal.
+   * \param proportion Position from the lowest band, 0, to Nyquist, 1.
+   * \return double Frequency in Hz.
+   */
+  static double getFrequency(double sampleRate, double proportion);
+
+private:
+  /**
+   * Bins a band is reduced from.
+   */
+  struct Band
+  {
+    int firstBin = 0;       /**< First bin inside the band */
+    int lastBin = -1;       /**< Last bin inside the band, before firstBin if none */
+    float centreBin = 0.f;  /**< Position of the band centre, interpolated when no bin is inside */
+  };
+
+  static constexpr int fifoLength = 1 << (maxOrder + 1); /**< Fifo capacity, two of the largest FFTs */
+  static constexpr int newFlag = 4;                      /**< Set on a latest index when it holds unread content */
+  static constexpr int indexMask = 3;                    /**< Extracts the slot index from a latest index */
+
+  /**
+   * Analyses every sample in the fifo until the thread is asked to exit.
+   *
+   */
+  void run() override;
+
+  /**
+   * Reallocates the analysis when the FFT size or the window changed.
+   *
+   */
+  void applyAnalysis();
+
+  /**
+   * Appends every sample of the fifo to the frames, and transforms each frame
+   * that gets complete.
+   *
+   * \return true if at least one spectrum was computed.
+   * \return false otherwise.
+   */
+  bool analyseReady();
+
+  /**
+   * Windows, transforms and averages the current frame of every channel.
+   *
+   */
+  void analyseFrame();
+
+  /**
+   * Reduces the averaged power of every channel to its bands, in decibels.
+   *
+   * \param bands numBands levels per channel.
+   */
+  void reduceToBands(float *bands) const;
+
+  /**
+   * Appends the bands of the current frame to the history, as the loudest
+   * channel of each band. The frame is dropped if the history is full.
+   *
+   */
+  void pushToHistory();
+
+  const int numChannels;                           /**< Analysed channels */
+  const double sampleRate;                         /**< Sample rate of the analysed signal */
+
+  std::atomic<int> requestedOrder{12};             /**< FFT order set by the message thread */
+  std::atomic<int> requestedWindow{0};             /**< Window set by the message thread */
+  std::atomic<float> requestedAveraging{0.f};      /**< Averaging time constant set by the message thread */
+
+  juce::AbstractFifo fifo{fifoLength};             /**< Indices of the sample fifo */
+  std::vector<std::vector<float>> fifoData;        /**< Samples pulled from the queue, per channel */
+  std::vector<float *> fifoPointers;               /**< Write position in each fifoData channel */
+
+  int order = 0;                                   /**< Current FFT order, 0 before the first analysis */
+  int window = -1;                                 /**< Current window */
+  int fftSize = 0;                                 /**< Current FFT size */
+  int hop = 0;                                     /**< Samples between two frames */
+  float smoothing = 1.f;                           /**< Weight of the latest frame in the average */
+  float powerScale = 1.f;                          /**< Brings a full-scale sine to unit power */
+  std::unique_ptr<juce::dsp::FFT> fft;             /**< Transform of the current size */
+  std::vector<float> windowTable;                  /**< Precomputed window of the current size */
+  std::vector<float> fftData;                      /**< Transform input and output, twice fftSize */
+  std::vector<std::vector<float>> frames;          /**< Last fftSize samples, per channel */
+  std::vector<std::vector<float>> averages;        /**< Averaged power of each bin, per channel */
+  std::vector<Band> bands;                         /**< Bins of each band */
+  int numSinceFrame = 0;                           /**< Samples appended since the last frame */
+  int numValid = 0;                                /**< Contiguous samples in the frames, up to fftSize */
+  juce::uint64 numQuietSamplesPulled = 0;          /**< Quiet samples moved to the fifo, message thread only */
+
+  juce::AbstractFifo historyFifo;                  /**< Indices of the frame history */
+  std::vector<float> historyData;                  /**< numBands levels per history frame */
+  std::vector<float> frameBands;                   /**< Bands of the current frame, per channel */
+
+  std::array<std::vector<float>, 3> spectra;       /**< Computed, latest & displayed bands */
+  int spectrumWriteIndex = 0;                      /**< Bands owned by the worker */
+  int spectrumReadIndex = 1;                       /**< Bands owned by the message thread */
+  std::atomic<int> latestSpectrum{2};              /**< Latest computed bands, plus newFlag */
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumWorker)
+};
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    TracePath.cpp
+    Created: 18 Oct 2026 3:12:08pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "TracePath.h"
+
+void TracePath::updateEnvelope(const float *mins, const float *maxs, size_t numColumns, juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // clear keeping allocated storage
+  outline.clear();
+
+  // need at least two columns
+  if (numColumns < 2)
+  {
+    return;
+  }
+
+  // get bounds
+  auto left = rect.getX();
+  auto center = rect.getBottom() - offset;
+  auto gain = rect.getHeight() * scaler;
+  updateXCoordinates(numColumns, rect.getWidth() / float(numColumns));
+
+  // trace upper edge left to right, then lower edge right to left, keeping it at least one pixel thick
+  outline.preallocateSpace(6 * (int)numColumns + 1);
+  outline.startNewSubPath(left, center - gain * maxs[0] - 0.5f);
+  for (size_t i = 1; i < numColumns; ++i)
+  {
+    outline.lineTo(left + xCoordinates[i], center - gain * maxs[i] - 0.5f);
+  }
+  for (size_t i = numColumns; i-- > 0;)
+  {
+    outline.lineTo(left + xCoordinates[i], center - gain * mins[i] + 0.5f);
+  }
+  outline.closeSubPath();
+}
+
+void TracePath::updateLine(const float *data, size_t numPoints, juce::Rectangle<float> rect, float scaler, float offset, float xShift)
+{
+  // clear keeping allocated storage
+  outline.clear();
+  line.clear();
+
+  // need at least two points
+  if (numPoints < 2)
+  {
+    return;
+  }
+
+  // get bounds
+  auto step = rect.getWidth() / float(numPoints);
+  auto left = rect.getX() + xShift * step;
+  auto center = rect.getBottom() - offset;
+  auto gain = rect.getHeight() * scaler;
+  updateXCoordinates(numPoints, step);
+
+  // build polyline
+  line.preallocateSpace(3 * (int)numPoints);
+  line.startNewSubPath(left, center - gain * data[0]);
+  for (size_t i = 1; i < numPoints; ++i)
+  {
+    line.lineTo(left + xCoordinates[i], center - gain * data[i]);
+  }
+
+  // stroke it once here, so that painting only fills
+  juce::PathStrokeType(1.0f).createStrokedPath(outline, line);
+}
+
+void TracePath::clear()
+{
+  outline.clear();
+  line.clear();
+}
+
+void TracePath::draw(juce::Graphics &g) const
+{
+  g.fillPath(outline);
+}
+
+void TracePath::updateXCoordinates(size_t numPoints, float step)
+{
+  // nothing changed
+  if (xCoordinates.size() == numPoints && cachedStep == step)
+  {
+    return;
+  }
+
+  // recompute
+  xCoordinates.resize(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    xCoordinates[i] = float(i) * step;
+  }
+  cachedStep = step;
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    TracePath.h
+    Created: 18 Oct 2026 3:12:08pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * Cached geometry of one trace.
+ *
+ * The outline is rebuilt once per new data frame into a reused juce::Path,
+ * with x coordinates precomputed for the current number of points and width,
+ * so that painting is a single fillPath call.
+ *
+ */
+class TracePath
+{
+public:
+  /**
+   * Rebuilds the trace as a min/max envelope of numColumns columns spread
+   * over rect, at least one pixel thick. Column i lies at i / numColumns of
+   * the width, as sample i does in @ref updateLine.
+   *
+   * \param mins Minimum of each column.
+   * \param maxs Maximum of each column.
+   * \param numColumns Number of columns.
+   * \param rect <a href="https://docs.juce.com/master/classRectangle.html">JUCE Rectangle </a>
+   * \param scaler Scale factor.
+   * \param offset Y-axis offset.
+   */
+  void updateEnvelope(const float *mins, const float *maxs, size_t numColumns, juce::Rectangle<float> rect, float scaler = float(1), float offset = float(0));
+
+  /**
+   * Rebuilds the trace as a one pixel line through numPoints samples spread
+   * over rect.
+   *
+   * \param data Samples.
+   * \param numPoints Number of samples.
+   * \param rect <a href="https://docs.juce.com/master/classRectangle.html">JUCE Rectangle </a>
+   * \param scaler Scale factor.
+   * \param offset Y-axis offset.
+   * \param xShift Shift of every point to the right, in samples.
+   */
+  void updateLine(const float *data, size_t numPoints, juce::Rectangle<float> rect, float scaler = float(1), float offset = float(0), float xShift = float(0));
+
+  /**
+   * Empties the trace.
+   *
+   */
+  void clear();
+
+  /**
+   * Draws the cached trace with the current colour.
+   *
+   * \param g <a href="https://docs.juce.com/master/classGraphics.html">JUCE Graphics </a>
+   */
+  void draw(juce::Graphics &g) const;
+
+private:
+  /**
+   * Recomputes the cached x coordinates if the number of points or their
+   * spacing changed.
+   *
+   * \param numPoints Number of points.
+   * \param step Distance between two points.
+   */
+  void updateXCoordinates(size_t numPoints, float step);
+
+  juce::Path outline;               /**< Filled outline of the trace */
+  juce::Path line;                  /**< Polyline the outline is stroked from */
+  std::vector<float> xCoordinates;  /**< x of each point relative to the left edge */
+  float cachedStep = 0;             /**< Spacing xCoordinates were computed with */
+};
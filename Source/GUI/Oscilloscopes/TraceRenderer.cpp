@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    TraceRenderer.cpp
+    Created: 18 Oct 2026 4:21:55pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "TraceRenderer.h"
+
+TraceRenderer::TraceRenderer() : juce::Thread("Oscilloscope Renderer")
+{
+  startThread();
+}
+
+TraceRenderer::~TraceRenderer()
+{
+  // wake the thread up so that it can exit
+  signalThreadShouldExit();
+  notify();
+  stopThread(1000);
+}
+
+void TraceRenderer::submit(std::vector<TracePath> &tracesToRender, int width, int height)
+{
+  // fill write job by swapping, no path is copied
+  auto &job = jobs[jobWriteIndex];
+  job.traces.swap(tracesToRender);
+  job.width = width;
+  job.height = height;
+
+  // publish & wake worker up
+  jobWriteIndex = latestJob.exchange(jobWriteIndex | newFlag, std::memory_order_acq_rel) & indexMask;
+  notify();
+}
+
+const juce::Image *TraceRenderer::acquireLatest()
+{
+  // swap only if something new was rendered
+  if (latestImage.load(std::memory_order_acquire) & newFlag)
+  {
+    imageReadIndex = latestImage.exchange(imageReadIndex, std::memory_order_acq_rel) & indexMask;
+    hasImage = true;
+  }
+  return hasImage ? &images[imageReadIndex] : nullptr;
+}
+
+void TraceRenderer::run()
+{
+  while (!threadShouldExit())
+  {
+    // sleep until a job is submitted
+    wait(-1);
+
+    // take latest job, if any
+    if (!(latestJob.load(std::memory_order_acquire) & newFlag))
+    {
+      continue;
+    }
+    jobReadIndex = latestJob.exchange(jobReadIndex, std::memory_order_acq_rel) & indexMask;
+
+    // render & publish
+    render(jobs[jobReadIndex], images[imageWriteIndex]);
+    imageWriteIndex = latestImage.exchange(imageWriteIndex | newFlag, std::memory_order_acq_rel) & indexMask;
+  }
+}
+
+void TraceRenderer::render(const Job &job, juce::Image &image)
+{
+  // nothing to render into
+  if (job.width <= 0 || job.height <= 0)
+  {
+    return;
+  }
+
+  // reallocate on resize only, otherwise clear to transparent
+  if (image.getWidth() != job.width || image.getHeight() != job.height)
+  {
+    image = juce::Image(juce::Image::ARGB, job.width, job.height, true, juce::SoftwareImageType());
+  }
+  else
+  {
+    image.clear(image.getBounds());
+  }
+
+  // rasterise each trace
+  juce::Graphics g(image);
+  for (size_t channel = 0; channel < job.traces.size(); ++channel)
+  {
+    g.setColour(CHANNELCOLOUR((int)channel));
+    job.traces[channel].draw(g);
+  }
+}
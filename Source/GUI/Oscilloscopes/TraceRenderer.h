@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    TraceRenderer.h
+    Created: 18 Oct 2026 4:21:55pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "TracePath.h"
+#include "../ColorPalette.h"
+
+/**
+ * Worker thread rasterising traces into a juce::Image with the software
+ * renderer, off the message thread.
+ *
+ * The message thread submits the traces of each new frame and blits the latest
+ * completed image in paint. Jobs and images are both handed over through
+ * lock-free triple buffers, so neither thread ever waits for the other.
+ *
+ * Inherits from <a href="https://docs.juce.com/master/classThread.html">JUCE Thread</a>
+ */
+class TraceRenderer : private juce::Thread
+{
+public:
+  /**
+   * Construct a new Trace Renderer object and starts its thread.
+   *
+   */
+  TraceRenderer();
+
+  /**
+   * Stops the thread and destroys the Trace Renderer object.
+   *
+   */
+  ~TraceRenderer() override;
+
+  /**
+   * Submits traces to render. To be called from the message thread only.
+   *
+   * The traces are swapped with those of an older job, so that their storage
+   * is reused without copying: after the call tracesToRender holds stale
+   * geometry that must be rebuilt before the next submission.
+   *
+   * \param tracesToRender Traces, one per channel.
+   * \param width Image width.
+   * \param height Image height.
+   */
+  void submit(std::vector<TracePath> &tracesToRender, int width, int height);
+
+  /**
+   * Acquires the most recently completed image. To be called from the message
+   * thread only. The image stays untouched until the next call.
+   *
+   * \return const juce::Image* Latest image, nullptr if nothing was rendered yet.
+   */
+  const juce::Image *acquireLatest();
+
+private:
+  /**
+   * Traces to render at a given size.
+   */
+  struct Job
+  {
+    std::vector<TracePath> traces; /**< Traces, one per channel */
+    int width = 0;                 /**< Image width */
+    int height = 0;                /**< Image height */
+  };
+
+  static constexpr int newFlag = 4;   /**< Set on a latest index when it holds unread content */
+  static constexpr int indexMask = 3; /**< Extracts the slot index from a latest index */
+
+  /**
+   * Renders every new job until the thread is asked to exit.
+   *
+   */
+  void run() override;
+
+  /**
+   * Rasterises a job.
+   *
+   * \param job Job to render.
+   * \param image Image to render into, reallocated if its size differs.
+   */
+  static void render(const Job &job, juce::Image &image);
+
+  std::array<Job, 3> jobs;           /**< Submitted, latest & rendered jobs */
+  int jobWriteIndex = 0;             /**< Job owned by the message thread */
+  int jobReadIndex = 1;              /**< Job owned by the worker */
+  std::atomic<int> latestJob{2};     /**< Latest submitted job, plus newFlag */
+
+  std::array<juce::Image, 3> images; /**< Rendered, latest & displayed images */
+  int imageWriteIndex = 0;           /**< Image owned by the worker */
+  int imageReadIndex = 1;            /**< Image owned by the message thread */
+  std::atomic<int> latestImage{2};   /**< Latest completed image, plus newFlag */
+  bool hasImage = false;             /**< Whether the message thread ever acquired an image */
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TraceRenderer)
+};
@@ -12,27 +12,16 @@
 
 TriggeredOscilloscope::TriggeredOscilloscope(OscilloscopeAudioProcessor &aProcessor, int sampleRate)
     : OscilloscopeComponent(aProcessor, sampleRate, aProcessor.getEditorRefreshRate())
-    , sampleFinder(
-      !aProcessor.getTreeState()->getParameterAsValue("slopeButtonTriggered").getValue(),
-      aProcessor.getTreeState()->getParameterAsValue("autoTriggered").getValue()
-    )
 {
   // get decay time
-  float decayTimeRelative = aProcessor.getTreeState()->getParameterAsValue("decayTime").getValue();
+  float decayTimeRelative = aProcessor.getParameterCache().getSnapshot().decayTime;
   decayTimeRelative = std::max(static_cast<float>(0.05), decayTimeRelative); // sometimes it inizializes to 0
 
   // reset decayCounter & add it as listener
   decayCounter.reset(
-      new DecayCounter(
-          aProcessor.getEditorRefreshRate(),
-          decayTimeRelative * OSCILLOSCOPE_MAX_DECAY_TIME()));
+      new DecayCounter(decayTimeRelative * OSCILLOSCOPE_MAX_DECAY_TIME()));
   aProcessor.getTreeState()->addParameterListener("decayTime", decayCounter.get());
 
-  // add sampleFinder listeners
-  aProcessor.getTreeState()->addParameterListener("autoTriggered", &sampleFinder);
-  aProcessor.getTreeState()->addParameterListener("slopeButtonTriggered", &sampleFinder.autoFinder);
-  aProcessor.getTreeState()->addParameterListener("slopeButtonTriggered", &sampleFinder.manualFinder);
-
   // refresh displayed data
   refreshDislayed();
 }
@@ -41,80 +30,171 @@ TriggeredOscilloscope::~TriggeredOscilloscope()
 {
   // remove listeners
   audioProcessor.getTreeState()->removeParameterListener("decayTime", decayCounter.get());
-  audioProcessor.getTreeState()->removeParameterListener("autoTriggered", &sampleFinder);
-  audioProcessor.getTreeState()->removeParameterListener("slopeButtonTriggered", &sampleFinder.autoFinder);
-  audioProcessor.getTreeState()->removeParameterListener("slopeButtonTriggered", &sampleFinder.manualFinder);
 }
 
 void TriggeredOscilloscope::refreshDislayed()
 {
-  // resize buffer and copy from sampleData
-  auto size = sampleData.size();
-  currentlyDisplayedData.resize(sampleData.size());
-  std::copy(sampleData.begin(), sampleData.end(), currentlyDisplayedData.begin());
+  // get latest frame found on the audio thread, keep the current one if none is new
+  auto frame = capture->buffers->frames.acquireLatest();
+  auto isNew = frame != nullptr && frame != displayedFrame;
+  if (!isNew && resampler.getEngine() == displayedEngine)
+  {
+    return;
+  }
+  if (isNew)
+  {
+    displayedFrame = frame;
+  }
+  displayedEngine = resampler.getEngine();
+  reduceDisplayed();
+}
+
+void TriggeredOscilloscope::reduceDisplayed()
+{
+  // nothing triggered yet
+  if (displayedFrame == nullptr)
+  {
+    return;
+  }
+  tracesNeedUpdate = true;
+
+  // reduce each channel to envelope when there are more samples than columns
+  auto numColumns = (size_t)getNumColumns();
+  if (displayedFrame->numSamples > numColumns)
+  {
+    displayedMin.resize((size_t)displayedFrame->numChannels);
+    displayedMax.resize(displayedMin.size());
+    for (int channel = 0; channel < displayedFrame->numChannels; ++channel)
+    {
+      displayedMin[channel].resize(numColumns);
+      displayedMax[channel].resize(numColumns);
+      PeakDecimator::process(displayedFrame->getChannel(channel), (int)displayedFrame->numSamples, displayedMin[channel].data(), displayedMax[channel].data(), (int)numColumns);
+    }
+  }
+  // otherwise reconstruct one point per column, placing the crossing at the trigger position
+  else if (isResampled())
+  {
+    auto step = double(displayedFrame->numSamples) / double(numColumns);
+    displayedLine.resize((size_t)displayedFrame->numChannels);
+    for (int channel = 0; channel < displayedFrame->numChannels; ++channel)
+    {
+      displayedLine[channel].resize(numColumns);
+      resampler.process(displayedFrame->getChannel(channel), (int)displayedFrame->numSamples, -double(displayedFrame->crossingOffset), step, displayedLine[channel].data(), (int)numColumns);
+    }
+  }
+}
 
-  // get trigger level
-  triggerLevel = audioProcessor.getTreeState()->getParameterAsValue("triggerLevel").getValue();
+bool TriggeredOscilloscope::isResampled() const
+{
+  return displayedFrame->numSamples <= (size_t)getNumColumns() && displayedEngine != DisplayResampler::Engine::linear;
+}
 
-  // reset firstSampleToPlot
-  const int offset = sampleFinder.findFirstSample(triggerLevel, currentlyDisplayedData);
-  firstSampleToPlot = currentlyDisplayedData.begin() + offset;
+void TriggeredOscilloscope::captureChanged()
+{
+  // frames of the previous geometry may be gone
+  displayedFrame = nullptr;
+}
 
-  // if not found display flat line
-  if (offset == -1)
+void TriggeredOscilloscope::layoutChanged()
+{
+  // columns of the displayed frame no longer match
+  reduceDisplayed();
+}
+
+void TriggeredOscilloscope::updateTraces(juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // nothing triggered yet
+  if (displayedFrame == nullptr || displayedFrame->numSamples < 2)
+  {
+    for (auto &trace : traces)
+    {
+      trace.clear();
+    }
+    return;
+  }
+
+  auto numSamples = displayedFrame->numSamples;
+  auto numTraces = std::min(traces.size(), (size_t)displayedFrame->numChannels);
+  for (size_t channel = 0; channel < numTraces; ++channel)
   {
-    std::fill(currentlyDisplayedData.begin(), currentlyDisplayedData.end(), 0.);
-    firstSampleToPlot = currentlyDisplayedData.begin();
+    // more samples than columns: envelope
+    if (numSamples > (size_t)getNumColumns())
+    {
+      traces[channel].updateEnvelope(displayedMin[channel].data(), displayedMax[channel].data(), displayedMin[channel].size(), rect, scaler, offset);
+    }
+    // otherwise line through the reconstructed waveform
+    else if (isResampled())
+    {
+      traces[channel].updateLine(displayedLine[channel].data(), displayedLine[channel].size(), rect, scaler, offset);
+    }
+    // or through every sample, shifted so that the crossing lies exactly at the trigger position
+    else
+    {
+      traces[channel].updateLine(displayedFrame->getChannel((int)channel), numSamples, rect, scaler, offset, float(displayedFrame->crossingOffset));
+    }
   }
 }
 
-void TriggeredOscilloscope::plot(juce::Graphics &g, juce::Rectangle<float> rect, float scaler, float offset)
+void TriggeredOscilloscope::splat(PhosphorBuffer &phosphor, juce::Rectangle<float> rect, float scaler, float offset)
 {
-  // get beginning and num samples
-  auto data = currentlyDisplayedData.begin();
-  auto numSamples = currentlyDisplayedData.size();
-
-  // get bounds
-  auto w = rect.getWidth();
-  auto h = rect.getHeight();
-  auto right = rect.getRight();
-  auto center = rect.getBottom() - offset;
-  auto gain = h * scaler;
-  g.setColour(WAVEFORMCOLOUR());
+  // nothing triggered yet
+  if (displayedFrame == nullptr || displayedFrame->numSamples < 2)
+  {
+    return;
+  }
 
-  // get distance of trigger point from beginning
-  int sampleOffset = std::distance(data, firstSampleToPlot);
+  auto numSamples = displayedFrame->numSamples;
+  for (int channel = 0; channel < displayedFrame->numChannels; ++channel)
+  {
+    // more samples than columns: envelope
+    if (numSamples > (size_t)getNumColumns())
+    {
+      phosphor.splatEnvelope(displayedMin[channel].data(), displayedMax[channel].data(), displayedMin[channel].size(), rect, scaler, offset);
+    }
+    // otherwise line through the reconstructed waveform
+    else if (isResampled())
+    {
+      phosphor.splatLine(displayedLine[channel].data(), displayedLine[channel].size(), rect, scaler, offset);
+    }
+    // or through every sample, crossing at the trigger position
+    else
+    {
+      phosphor.splatLine(displayedFrame->getChannel(channel), numSamples, rect, scaler, offset, float(displayedFrame->crossingOffset));
+    }
+  }
+}
+
+void TriggeredOscilloscope::plot(juce::Graphics &g, juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // draw cached traces
+  for (size_t channel = 0; channel < traces.size(); ++channel)
+  {
+    g.setColour(CHANNELCOLOUR((int)channel));
+    traces[channel].draw(g);
+  }
 
-  // ratio sampleOffset / numSamples to map correctly waveform
-  float widthRatio = sampleOffset / numSamples;
+  plotOverlay(g, rect, scaler, offset);
+}
 
-  // for each point map & draw line
-  for (size_t i = 1; i < numSamples - sampleOffset; ++i)
+void TriggeredOscilloscope::plotOverlay(juce::Graphics &g, juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // if nothing triggered yet display flat line
+  g.setColour(WAVEFORMCOLOUR());
+  if (displayedFrame == nullptr || displayedFrame->numSamples < 2)
   {
-    auto xMapPrevious = juce::jmap(
-        float(i - 1),
-        float(sampleOffset),
-        float(numSamples - 1),
-        float(right - w),
-        float(right * (1 - widthRatio)));
-    auto xMap = juce::jmap(
-        float(i),
-        float(sampleOffset),
-        float(numSamples - 1),
-        float(right - w),
-        float(right * (1 - widthRatio)));
-
-    g.drawLine({xMapPrevious,
-                center - gain * firstSampleToPlot[i - 1],
-                xMap,
-                center - gain * firstSampleToPlot[i]});
+    g.drawLine(rect.getX(), rect.getBottom() - offset, rect.getRight(), rect.getBottom() - offset);
+    return;
   }
+
+  // mark trigger position
+  auto triggerX = rect.getX() + rect.getWidth() * float(displayedFrame->triggerIndex) / float(displayedFrame->numSamples);
+  g.drawLine(triggerX, rect.getY(), triggerX, rect.getY() + 8);
 }
 
-void TriggeredOscilloscope::subclassSpecificCallback()
+void TriggeredOscilloscope::subclassSpecificCallback(double elapsedSeconds)
 {
-  // if refresh is needed refresh displayed data
-  if (decayCounter.get()->refreshNeeded())
+  // if refresh is needed refresh displayed data, every new frame is accumulated in persistence mode
+  if (decayCounter.get()->refreshNeeded(elapsedSeconds) || isPersistent())
   {
     refreshDislayed();
   }
@@ -13,8 +13,11 @@
 #include "DecayCounter.h"
 #include "../../InitVariables.h"
 #include "../../GUI/ColorPalette.h"
-#include "SampleFinder.h"
 
+/**
+ * Triggered oscilloscope. Displays the trigger-aligned frames found on the
+ * audio thread, holding each one for the decay time.
+ */
 class TriggeredOscilloscope : public OscilloscopeComponent
 {
 
@@ -34,41 +37,80 @@ public:
   ~TriggeredOscilloscope();
 
   /**
-   * Refreshes displayed data and finds first element to plot.
+   * Refreshes displayed data with the latest triggered frame.
    *
    */
   void refreshDislayed();
 
 private:
   /**
-   * Current trigger level.
+   * Class keeping track of decay time.
    *
    */
-  float triggerLevel;
+  std::unique_ptr<DecayCounter> decayCounter;
 
   /**
-   * Class keeping track of decay time.
+   * Frame currently displayed, owned by the processor's TriggeredFrameBuffer.
    *
    */
-  std::unique_ptr<DecayCounter> decayCounter;
+  const TriggeredFrameBuffer<float>::Frame *displayedFrame = nullptr;
+
+  /**
+   * Minimum of each column of each channel of displayedFrame, when it has more
+   * samples than columns.
+   *
+   */
+  std::vector<std::vector<float>> displayedMin;
+
+  /**
+   * Maximum of each column of each channel of displayedFrame, when it has more
+   * samples than columns.
+   *
+   */
+  std::vector<std::vector<float>> displayedMax;
+
+  /**
+   * Each channel of displayedFrame resampled to one point per column, when it
+   * has fewer samples than columns and the resampler is not linear. The
+   * crossing offset is already applied.
+   *
+   */
+  std::vector<std::vector<float>> displayedLine;
 
   /**
-   * Data currently displayed.
+   * Resampler engine displayedLine was computed with.
    *
    */
-  std::vector<float> currentlyDisplayedData;
+  DisplayResampler::Engine displayedEngine = DisplayResampler::Engine::linear;
 
   /**
-   * First sample to plot.
+   * Returns whether channels are drawn from @ref displayedLine.
    *
+   * \return true if displayedFrame was resampled to the columns.
+   * \return false otherwise.
    */
-  std::vector<float>::iterator firstSampleToPlot;
+  bool isResampled() const;
 
   /**
-   * Class handling the logic to find the first sample to plot.
+   * Reduces or resamples displayedFrame to the current number of columns.
    *
    */
-  SampleFinder sampleFinder;
+  void reduceDisplayed();
+
+  void captureChanged() override;
+
+  void layoutChanged() override;
+
+  void updateTraces(
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  void splat(
+      PhosphorBuffer &phosphor,
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
 
   void plot(
       juce::Graphics &g,
@@ -76,5 +118,11 @@ private:
       float scaler = float(1),
       float offset = float(0)) override;
 
-  void subclassSpecificCallback() override;
+  void plotOverlay(
+      juce::Graphics &g,
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  void subclassSpecificCallback(double elapsedSeconds) override;
 };
@@ -15,33 +15,35 @@ UntriggeredOscilloscope::UntriggeredOscilloscope(OscilloscopeAudioProcessor &aPr
 {
 }
 
+void UntriggeredOscilloscope::updateTraces(juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // envelope of all displayed columns, one trace per channel
+  for (int channel = 0; channel < numChannels; ++channel)
+  {
+    traces[channel].updateEnvelope(minData.getWindow(channel), maxData.getWindow(channel), (size_t)getNumColumns(), rect, scaler, offset);
+  }
+}
+
+void UntriggeredOscilloscope::splat(PhosphorBuffer &phosphor, juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // envelope of all displayed columns of every channel
+  for (int channel = 0; channel < numChannels; ++channel)
+  {
+    phosphor.splatEnvelope(minData.getWindow(channel), maxData.getWindow(channel), (size_t)getNumColumns(), rect, scaler, offset);
+  }
+}
+
 void UntriggeredOscilloscope::plot(juce::Graphics &g, juce::Rectangle<float> rect, float scaler, float offset)
 {
-  // get beginning and num samples
-  auto data = sampleData.data();
-  auto numSamples = sampleData.size();
-
-  // get bounds
-  auto w = rect.getWidth();
-  auto h = rect.getHeight();
-  auto right = rect.getRight();
-  auto center = rect.getBottom() - offset;
-  auto gain = h * scaler;
-
-  // set colour
-  g.setColour(WAVEFORMCOLOUR());
-
-  // for each point map and draw line
-  for (size_t i = 1; i < numSamples; ++i)
+  // draw cached envelopes
+  for (size_t channel = 0; channel < traces.size(); ++channel)
   {
-    g.drawLine({juce::jmap(float(i - 1), float(0), float(numSamples - 1), float(right - w), float(right)),
-                center - gain * data[i - 1],
-                juce::jmap(float(i), float(0), float(numSamples - 1), float(right - w), float(right)),
-                center - gain * data[i]});
+    g.setColour(CHANNELCOLOUR((int)channel));
+    traces[channel].draw(g);
   }
 }
 
-void UntriggeredOscilloscope::subclassSpecificCallback()
+void UntriggeredOscilloscope::subclassSpecificCallback(double elapsedSeconds)
 {
   // Nothing to do for this subclass
   return;
@@ -15,7 +15,7 @@
 
 /**
  * Untriggered oscilloscope. Displays data continuously updating with no control
- * over trigger point and phase.
+ * over trigger point and phase, drawn as a filled min/max envelope.
  */
 class UntriggeredOscilloscope : public OscilloscopeComponent
 {
@@ -29,11 +29,22 @@ public:
   UntriggeredOscilloscope(OscilloscopeAudioProcessor &aProcessor, int sampleRate);
 
 private:
+  void updateTraces(
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  void splat(
+      PhosphorBuffer &phosphor,
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
   void plot(
       juce::Graphics &g,
       juce::Rectangle<float> rect,
       float scaler = float(1),
       float offset = float(0)) override;
 
-  void subclassSpecificCallback() override;
+  void subclassSpecificCallback(double elapsedSeconds) override;
 };
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    XYOscilloscope.cpp
+    Created: 19 Oct 2026 1:14:52am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#include "XYOscilloscope.h"
+#include <cmath>
+
+XYOscilloscope::XYOscilloscope(OscilloscopeAudioProcessor &aProcessor, int sampleRate, bool isMidSide)
+    : OscilloscopeComponent(aProcessor, sampleRate, aProcessor.getEditorRefreshRate()),
+      isMidSide(isMidSide)
+{
+  xs.resize(chunkLength);
+  ys.resize(chunkLength);
+}
+
+void XYOscilloscope::drawGrid(juce::Graphics &g, float w, float h)
+{
+  // set graphics parameters
+  g.setColour(juce::Colours::ghostwhite);
+  g.setOpacity(0.4);
+  auto area = getPlotArea();
+  auto centre = area.getCentre();
+
+  // axes of both channels and full scale
+  g.drawLine(area.getX(), centre.y, area.getRight(), centre.y);
+  g.drawLine(centre.x, area.getY(), centre.x, area.getBottom());
+  g.drawEllipse(area, 1.f);
+
+  // label the direction of each channel alone
+  auto half = area.getWidth() / 2.f;
+  auto diagonal = half / std::sqrt(2.f);
+  if (isMidSide)
+  {
+    g.drawLine(centre.x - diagonal, centre.y - diagonal, centre.x + diagonal, centre.y + diagonal);
+    g.drawLine(centre.x + diagonal, centre.y - diagonal, centre.x - diagonal, centre.y + diagonal);
+    g.drawSingleLineText("L", (int)(centre.x - diagonal) - 12, (int)(centre.y - diagonal));
+    g.drawSingleLineText("R", (int)(centre.x + diagonal) + 4, (int)(centre.y - diagonal));
+    g.drawSingleLineText("M", (int)centre.x + 4, (int)area.getY() + 12);
+    g.drawSingleLineText("S", (int)area.getRight() - 12, (int)centre.y - 4);
+  }
+  else
+  {
+    g.drawSingleLineText("L", (int)area.getRight() - 12, (int)centre.y - 4);
+    g.drawSingleLineText("R", (int)centre.x + 4, (int)area.getY() + 12);
+  }
+}
+
+juce::Rectangle<float> XYOscilloscope::getPlotArea() const
+{
+  // square, so that a circle stays a circle
+  auto bounds = getLocalBounds().toFloat().reduced(4.f);
+  auto side = std::min(bounds.getWidth(), bounds.getHeight());
+  return bounds.withSizeKeepingCentre(side, side);
+}
+
+void XYOscilloscope::renderCapture()
+{
+  auto &queue = capture->buffers->queue;
+  density.setSize(getWidth(), getHeight());
+
+  // one chunk buffer per queue channel, reallocated on reconfiguration only
+  if (chunk.size() != (size_t)queue.getNumChannels())
+  {
+    chunk.assign((size_t)queue.getNumChannels(), std::vector<float>(chunkLength));
+    chunkPointers.resize(chunk.size());
+    for (size_t channel = 0; channel < chunk.size(); ++channel)
+    {
+      chunkPointers[channel] = chunk[channel].data();
+    }
+  }
+
+  // every pair captured since the previous frame
+  auto area = getPlotArea();
+  auto intensity = densityPerSecond / float(capture->geometry.sampleRate);
+  auto left = chunk[0].data();
+  auto right = chunk.size() > 1 ? chunk[1].data() : left;
+  while (auto numPopped = (int)queue.pop(chunkPointers.data(), chunkLength))
+  {
+    if (isMidSide)
+    {
+      // side horizontally, mid vertically, left alone going up-left
+      juce::FloatVectorOperations::subtract(xs.data(), right, left, numPopped);
+      juce::FloatVectorOperations::multiply(xs.data(), juce::MathConstants<float>::sqrt2 / 2.f, numPopped);
+      juce::FloatVectorOperations::add(ys.data(), left, right, numPopped);
+      juce::FloatVectorOperations::multiply(ys.data(), juce::MathConstants<float>::sqrt2 / 2.f, numPopped);
+      density.splatPoints(xs.data(), ys.data(), (size_t)numPopped, area, intensity);
+    }
+    else
+    {
+      density.splatPoints(left, right, (size_t)numPopped, area, intensity);
+    }
+    hasNewPoints = true;
+  }
+}
+
+void XYOscilloscope::updateTraces(juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // Nothing to do, points are splatted as they arrive
+  return;
+}
+
+void XYOscilloscope::splat(PhosphorBuffer &phosphor, juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // Never called, the density is a persistence of its own
+  return;
+}
+
+void XYOscilloscope::plot(juce::Graphics &g, juce::Rectangle<float> rect, float scaler, float offset)
+{
+  // blit tone-mapped density
+  if (densityImage.isValid())
+  {
+    g.drawImageAt(densityImage, 0, 0);
+  }
+}
+
+void XYOscilloscope::subclassSpecificCallback(double elapsedSeconds)
+{
+  // a faded density stays black until new points arrive
+  auto decaySeconds = std::max(0.05f, parameters.decayTime) * OSCILLOSCOPE_MAX_PERSISTENCE_TIME();
+  if (!hasNewPoints && fadingSeconds > fadeOutTimeConstants * decaySeconds)
+  {
+    return;
+  }
+  fadingSeconds = hasNewPoints ? 0.f : fadingSeconds + float(elapsedSeconds);
+  hasNewPoints = false;
+
+  // exponential decay, then tone mapping
+  density.decay(std::exp(-float(elapsedSeconds) / decaySeconds));
+  density.toneMap(densityImage);
+  tracesNeedUpdate = true;
+}
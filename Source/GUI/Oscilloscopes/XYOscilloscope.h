@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    XYOscilloscope.h
+    Created: 19 Oct 2026 1:14:52am
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "OscilloscopeComponent.h"
+#include "../../InitVariables.h"
+#include "../../GUI/ColorPalette.h"
+
+/**
+ * XY oscilloscope. Plots the first two channels against each other, left
+ * horizontally and right vertically, or rotated by 45 degrees as a goniometer
+ * with mid vertically and side horizontally. A mono input is plotted against
+ * itself.
+ *
+ * Every captured sample pair is splatted as a point into a @ref PhosphorBuffer
+ * decaying over the decay time, so that the cost of a frame is a fixed
+ * tone-mapping pass plus a few operations per new point, however many points
+ * the history holds.
+ */
+class XYOscilloscope : public OscilloscopeComponent
+{
+public:
+  /**
+   * Construct a new XY Oscilloscope object
+   *
+   * \param aProcessor PluginProcessor audio processor.
+   * \param sampleRate Sample rate of the host.
+   * \param isMidSide Whether to plot mid against side instead of left against right.
+   */
+  XYOscilloscope(OscilloscopeAudioProcessor &aProcessor, int sampleRate, bool isMidSide);
+
+  /**
+   * Draws the axes and the unit circle.
+   *
+   * \param g <a href="https://docs.juce.com/master/classGraphics.html">JUCE Graphics </a>.
+   * \param w width.
+   * \param h heigth.
+   */
+  void drawGrid(juce::Graphics &g, float w, float h) override;
+
+private:
+  static constexpr size_t chunkLength = 4096;           /**< Sample pairs popped at once */
+  static constexpr float densityPerSecond = 4800.f;     /**< Intensity added by one second of points */
+  static constexpr float fadeOutTimeConstants = 6.f;    /**< Decay time constants after which the density is black */
+
+  const bool isMidSide;                                 /**< Whether to plot mid against side */
+  PhosphorBuffer density{WAVEFORMCOLOUR()};             /**< Decaying density of the points */
+  juce::Image densityImage;                             /**< Tone-mapped density */
+  std::vector<std::vector<float>> chunk;                /**< Popped samples, one buffer per queue channel */
+  std::vector<float *> chunkPointers;                   /**< Pointers to the chunk buffers */
+  std::vector<float> xs;                                /**< Horizontal coordinate of each popped pair */
+  std::vector<float> ys;                                /**< Vertical coordinate of each popped pair */
+  bool hasNewPoints = false;                            /**< Whether points were splatted since the last tone mapping */
+  float fadingSeconds = 0.f;                            /**< Time since points were last splatted */
+
+  /**
+   * Get the square area the points are spread over, centred in the component.
+   *
+   * \return juce::Rectangle<float> Plot area.
+   */
+  juce::Rectangle<float> getPlotArea() const;
+
+  /**
+   * Pops every sample pair of the AudioBufferQueue and splats it into the
+   * density buffer.
+   *
+   */
+  void renderCapture() override;
+
+  bool drawsTraces() const override { return false; }
+
+  void updateTraces(
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  void splat(
+      PhosphorBuffer &phosphor,
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  void plot(
+      juce::Graphics &g,
+      juce::Rectangle<float> rect,
+      float scaler = float(1),
+      float offset = float(0)) override;
+
+  /**
+   * Decays the density over the decay time and tone-maps it. Does nothing once
+   * it faded to black and no new points arrived.
+   *
+   * \param elapsedSeconds Seconds elapsed since the previous frame.
+   */
+  void subclassSpecificCallback(double elapsedSeconds) override;
+};
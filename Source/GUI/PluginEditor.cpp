@@ -15,7 +15,8 @@ OscilloscopeAudioProcessorEditor::OscilloscopeAudioProcessorEditor(OscilloscopeA
 {
 
   // set correct oscilloscopeComponent height
-  if (audioProcessor.getTreeState()->getParameterAsValue("isProfessional").getValue())
+  auto parameters = audioProcessor.getParameterCache().getSnapshot();
+  if (parameters.isProfessional)
   {
     margin_multiplier = GUI_EXPANDED_MARGIN_MULTIPLIER();
   }
@@ -25,22 +26,16 @@ OscilloscopeAudioProcessorEditor::OscilloscopeAudioProcessorEditor(OscilloscopeA
   }
 
   // reset oscilloscopeComponent and guiTransformer pointers
-  if (audioProcessor.getTreeState()->getParameterAsValue("isProfessional").getValue())
-  {
-    oscilloscopeComponent.reset(new TriggeredOscilloscope(audioProcessor, audioProcessor.getSampleRate()));
-  }
-  else
-  {
-    oscilloscopeComponent.reset(new UntriggeredOscilloscope(audioProcessor, audioProcessor.getSampleRate()));
-  }
+  oscilloscopeComponent.reset(createOscilloscope(parameters.isProfessional));
 
   guiTransformer.reset(new GuiTransformer(
       audioProcessor,
+      *this,
       GUI_EXPAND_ANIMATION_DURATION(),
-      [this]()
-      { this->expandCallback(); },
-      [this]()
-      { this->contractCallback(); },
+      [this](float fraction)
+      { this->expandCallback(fraction); },
+      [this](float fraction)
+      { this->contractCallback(fraction); },
       [this]()
       { this->expansionStartedCallback(); },
       [this]()
@@ -50,29 +45,24 @@ OscilloscopeAudioProcessorEditor::OscilloscopeAudioProcessorEditor(OscilloscopeA
       [this]()
       { this->contractionEndedCallback(); }));
 
-  // reset triggerListener
+  // reset triggerListener, the view is rebuilt on the message thread
   triggerListener.reset(
       new TriggerListener(
           // callback to reset to triggered state
           [this]()
-          {
-            removeChildComponent(oscilloscopeComponent.get());
-            oscilloscopeComponent.reset(
-                new TriggeredOscilloscope(audioProcessor, audioProcessor.getSampleRate()));
-            addAndMakeVisible(oscilloscopeComponent.get());
-            resized();
-          },
+          { triggerAsyncUpdate(); },
           // callback to reset to untriggered state
           [this]()
-          {
-            removeChildComponent(oscilloscopeComponent.get());
-            oscilloscopeComponent.reset(
-                new UntriggeredOscilloscope(audioProcessor, audioProcessor.getSampleRate()));
-            addAndMakeVisible(oscilloscopeComponent.get());
-            resized();
-          }));
+          { triggerAsyncUpdate(); }));
   audioProcessor.getTreeState()->addParameterListener("isTriggered", triggerListener.get());
 
+  // reset displayModeListener, the trigger state is kept across modes
+  displayModeListener.reset(
+      new DisplayModeListener(
+          [this](DisplayModeListener::Mode)
+          { triggerAsyncUpdate(); }));
+  audioProcessor.getTreeState()->addParameterListener("displayMode", displayModeListener.get());
+
   // add and make visible components
   addAndMakeVisible(oscilloscopeComponent.get());
   addAndMakeVisible(controlSection);
@@ -92,8 +82,35 @@ OscilloscopeAudioProcessorEditor::OscilloscopeAudioProcessorEditor(OscilloscopeA
   attachmentNames.push_back("refreshTime");
   attachmentNames.push_back("muteOutput");
   attachmentNames.push_back("decayTime");
+  attachmentNames.push_back("triggerPosition");
+  attachmentNames.push_back("holdoffTime");
+  attachmentNames.push_back("backgroundRender");
+  attachmentNames.push_back("persistence");
+  attachmentNames.push_back("resampler");
+  attachmentNames.push_back("displayMode");
+  attachmentNames.push_back("fftSize");
+  attachmentNames.push_back("fftWindow");
+  attachmentNames.push_back("spectrumAveraging");
   controlSection.setMultipleAttachments(attachmentNames, *audioProcessor.getTreeState());
 
+  // recording outlives the editor, show its state & revert the button if the file cannot be opened
+  controlSection.setRecordState(audioProcessor.getRecorder().isRecording());
+  controlSection.setRecordCallback(
+      [this](bool shouldRecord)
+      {
+        auto &recorder = audioProcessor.getRecorder();
+        if (shouldRecord)
+        {
+          controlSection.setRecordState(recorder.start(CaptureRecorder::getDefaultFile()));
+        }
+        else
+        {
+          recorder.stop();
+        }
+      });
+  controlSection.setOpenCaptureCallback([this]()
+                                        { openCapture(); });
+
   // set resize options
   setResizable(true, true);
   setResizeLimits(256, 256, 1920, 1080);
@@ -101,6 +118,78 @@ OscilloscopeAudioProcessorEditor::OscilloscopeAudioProcessorEditor(OscilloscopeA
 
 OscilloscopeAudioProcessorEditor::~OscilloscopeAudioProcessorEditor()
 {
+  // listeners must not outlive the editor
+  audioProcessor.getTreeState()->removeParameterListener("isTriggered", triggerListener.get());
+  audioProcessor.getTreeState()->removeParameterListener("displayMode", displayModeListener.get());
+  cancelPendingUpdate();
+
+  // the viewer window must not outlive the plugin code
+  delete captureWindow.getComponent();
+}
+
+OscilloscopeComponent *OscilloscopeAudioProcessorEditor::createOscilloscope(bool isTriggered)
+{
+  // only the scope has a trigger
+  auto mode = (DisplayModeListener::Mode)audioProcessor.getParameterCache().getSnapshot().displayMode;
+  if (mode == DisplayModeListener::Mode::spectrum)
+  {
+    return new SpectrumAnalyser(audioProcessor, audioProcessor.getSampleRate());
+  }
+  if (mode == DisplayModeListener::Mode::spectrogram)
+  {
+    return new Spectrogram(audioProcessor, audioProcessor.getSampleRate());
+  }
+  if (mode == DisplayModeListener::Mode::xy || mode == DisplayModeListener::Mode::goniometer)
+  {
+    return new XYOscilloscope(audioProcessor, audioProcessor.getSampleRate(), mode == DisplayModeListener::Mode::goniometer);
+  }
+  if (isTriggered)
+  {
+    return new TriggeredOscilloscope(audioProcessor, audioProcessor.getSampleRate());
+  }
+  return new UntriggeredOscilloscope(audioProcessor, audioProcessor.getSampleRate());
+}
+
+void OscilloscopeAudioProcessorEditor::showOscilloscope(bool isTriggered)
+{
+  // replace the displayed component
+  removeChildComponent(oscilloscopeComponent.get());
+  oscilloscopeComponent.reset(createOscilloscope(isTriggered));
+  addAndMakeVisible(oscilloscopeComponent.get());
+  resized();
+}
+
+void OscilloscopeAudioProcessorEditor::handleAsyncUpdate()
+{
+  // changes posted since coalesce into one, shown as they are now
+  showOscilloscope(audioProcessor.getParameterCache().getSnapshot().isTriggered);
+}
+
+void OscilloscopeAudioProcessorEditor::openCapture()
+{
+  // recordings land next to the default file
+  captureChooser.reset(new juce::FileChooser("Open Capture",
+                                             CaptureRecorder::getDefaultFile().getParentDirectory(),
+                                             juce::String("*") + CaptureFileFormat::fileExtension));
+  captureChooser->launchAsync(
+      juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+      [this](const juce::FileChooser &chooser)
+      {
+        auto file = chooser.getResult();
+        if (!file.existsAsFile())
+        {
+          return;
+        }
+
+        // one viewer at a time, mapping the file lazily
+        delete captureWindow.getComponent();
+        juce::DialogWindow::LaunchOptions options;
+        options.content.setOwned(new CaptureViewer(file));
+        options.dialogTitle = file.getFileName();
+        options.dialogBackgroundColour = juce::Colours::black;
+        options.resizable = true;
+        captureWindow = options.launchAsync();
+      });
 }
 
 //==============================================================================
@@ -127,15 +216,14 @@ void OscilloscopeAudioProcessorEditor::resized()
   audioProcessor.storeEditorSize(getWidth(), getHeight());
 }
 
-void OscilloscopeAudioProcessorEditor::expandCallback()
+void OscilloscopeAudioProcessorEditor::expandCallback(float fraction)
 {
 
   if (this->margin_multiplier > GUI_EXPANDED_MARGIN_MULTIPLIER())
   {
-    // increase by a fraction of the difference in pixels such that it takes the correct amount of frames
+    // increase by the fraction of the difference in pixels covered by the elapsed time
     float difference = GUI_CONTRACTED_MARGIN_MULTIPLIER() - GUI_EXPANDED_MARGIN_MULTIPLIER();
-    float totalFrames = float(EDITOR_INITIAL_RATE()) * GUI_EXPAND_ANIMATION_DURATION();
-    float increment = difference / totalFrames;
+    float increment = difference * fraction;
     this->margin_multiplier = this->margin_multiplier - increment;
   }
   else
@@ -154,16 +242,14 @@ void OscilloscopeAudioProcessorEditor::expansionEndedCallback()
   this->resized();
 }
 
-void OscilloscopeAudioProcessorEditor::contractCallback()
+void OscilloscopeAudioProcessorEditor::contractCallback(float fraction)
 {
 
   if (this->margin_multiplier < GUI_CONTRACTED_MARGIN_MULTIPLIER())
   {
-    // increase by a fraction of the difference in pixels such that it takes the correct amount of frames
+    // increase by the fraction of the difference in pixels covered by the elapsed time
     float difference = GUI_CONTRACTED_MARGIN_MULTIPLIER() - GUI_EXPANDED_MARGIN_MULTIPLIER();
-    ;
-    float totalFrames = float(EDITOR_INITIAL_RATE()) * GUI_EXPAND_ANIMATION_DURATION();
-    float increment = difference / totalFrames;
+    float increment = difference * fraction;
     this->margin_multiplier = this->margin_multiplier + increment;
   }
   else
@@ -13,14 +13,20 @@
 #include "../GUI/Oscilloscopes/OscilloscopeComponent.h"
 #include "../GUI/Oscilloscopes/UntriggeredOscilloscope.h"
 #include "../GUI/Oscilloscopes/TriggeredOscilloscope.h"
+#include "../GUI/Oscilloscopes/SpectrumAnalyser.h"
+#include "../GUI/Oscilloscopes/Spectrogram.h"
+#include "../GUI/Oscilloscopes/XYOscilloscope.h"
 #include "../GUI/Controls/ControlSection.h"
 #include "GuiTransformer.h"
+#include "CaptureViewer.h"
 #include "../GUI/Oscilloscopes/TriggerListener.h"
+#include "../GUI/Oscilloscopes/DisplayModeListener.h"
 
 //==============================================================================
 /**
  */
-class OscilloscopeAudioProcessorEditor : public juce::AudioProcessorEditor
+class OscilloscopeAudioProcessorEditor : public juce::AudioProcessorEditor,
+                                         private juce::AsyncUpdater
 {
 public:
   OscilloscopeAudioProcessorEditor(OscilloscopeAudioProcessor &);
@@ -55,12 +61,60 @@ private:
   std::unique_ptr<TriggerListener> triggerListener;
 
   /**
-   * Currently plotted oscilloscope. Can be TriggeredOscilloscope
-   * or UntriggeredOscilloscope.
+   * DisplayModeListener. Handles which view to plot.
+   *
+   */
+  std::unique_ptr<DisplayModeListener> displayModeListener;
+
+  /**
+   * Currently plotted oscilloscope. Can be TriggeredOscilloscope,
+   * UntriggeredOscilloscope, SpectrumAnalyser, Spectrogram or
+   * XYOscilloscope.
    *
    */
   std::unique_ptr<OscilloscopeComponent> oscilloscopeComponent;
 
+  /**
+   * Creates the oscilloscope of the current display mode.
+   *
+   * \param isTriggered Whether the scope view is triggered.
+   * \return OscilloscopeComponent* New component, owned by the caller.
+   */
+  OscilloscopeComponent *createOscilloscope(bool isTriggered);
+
+  /**
+   * Replaces the plotted oscilloscope with one of the current display mode.
+   *
+   * \param isTriggered Whether the scope view is triggered.
+   */
+  void showOscilloscope(bool isTriggered);
+
+  /**
+   * Replaces the plotted oscilloscope on the message thread. Parameter
+   * listeners run on the thread that set the parameter, the audio thread
+   * under automation, so they only post this update.
+   *
+   */
+  void handleAsyncUpdate() override;
+
+  /**
+   * Chooser of the capture file to view, kept alive while it is shown.
+   *
+   */
+  std::unique_ptr<juce::FileChooser> captureChooser;
+
+  /**
+   * Window showing a CaptureViewer, closed with the editor.
+   *
+   */
+  juce::Component::SafePointer<juce::DialogWindow> captureWindow;
+
+  /**
+   * Asks for a capture file and shows it in a viewer window.
+   *
+   */
+  void openCapture();
+
   /**
    * Display component heigth over PluginEditor heigth
    *
@@ -68,9 +122,9 @@ private:
   float margin_multiplier;
 
   // GUI animation callbacks
-  void expandCallback();
+  void expandCallback(float fraction);
   void expansionEndedCallback();
-  void contractCallback();
+  void contractCallback(float fraction);
   void contractionEndedCallback();
   void expansionStartedCallback();
   void contractionStartedCallback();
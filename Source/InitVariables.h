@@ -29,11 +29,20 @@ static constexpr int EDITOR_INITIAL_WIDTH() { return 1400; };
 static constexpr int EDITOR_INITIAL_HEIGHT() { return 700; }
 
 /**
- * Editor initial frame rate.
+ * Highest editor frame rate. Frames follow the display's vertical blank, so
+ * the actual rate is at most the display's.
  *
- * \return constexpr int Editor initial frame rate.
+ * \return constexpr int Editor max frame rate.
  */
-static constexpr int EDITOR_INITIAL_RATE() { return 30; }
+static constexpr int EDITOR_MAX_RATE() { return 144; }
+
+/**
+ * Editor frame rate when nothing changes, nothing is shown or frames exceed
+ * their CPU budget. Capture queues hold enough samples for it.
+ *
+ * \return constexpr int Editor idle frame rate.
+ */
+static constexpr int EDITOR_IDLE_RATE() { return 10; }
 
 /**
  * GUI expansion animation duration.
@@ -63,4 +72,65 @@ static constexpr float GUI_EXPANDED_MARGIN_MULTIPLIER() { return 10.5 / 13.; }
  *
  * \return constexpr float Max decay time of TriggeredOscilloscope.
  */
-static constexpr float OSCILLOSCOPE_MAX_DECAY_TIME() { return 10.; }
\ No newline at end of file
+static constexpr float OSCILLOSCOPE_MAX_DECAY_TIME() { return 10.; }
+
+/**
+ * Max persistence time of the phosphor display mode, i.e. the time constant
+ * of its exponential decay.
+ *
+ * \return constexpr float Max persistence time.
+ */
+static constexpr float OSCILLOSCOPE_MAX_PERSISTENCE_TIME() { return 2.; }
+
+/**
+ * Shortest window the oscilloscope can display, in seconds.
+ *
+ * \return constexpr float Shortest displayable window.
+ */
+static constexpr float OSCILLOSCOPE_MIN_LENGTH() { return 0.001; }
+
+/**
+ * Longest window the oscilloscope can display, in seconds.
+ *
+ * \return constexpr float Longest displayable window.
+ */
+static constexpr float OSCILLOSCOPE_MAX_LENGTH() { return 300.; }
+
+/**
+ * Longest window drawn from raw samples, in seconds. Longer windows are
+ * rendered from the SummaryPyramid.
+ *
+ * \return constexpr float Longest window drawn from raw samples.
+ */
+static constexpr float OSCILLOSCOPE_MAX_RAW_LENGTH() { return 1.; }
+
+/**
+ * Max holdoff time of the trigger, in seconds.
+ *
+ * \return constexpr float Max holdoff time.
+ */
+static constexpr float OSCILLOSCOPE_MAX_HOLDOFF_TIME() { return 1.; }
+
+/**
+ * Max number of channels the oscilloscope captures and displays, sidechain
+ * included.
+ *
+ * \return constexpr int Max number of displayed channels.
+ */
+static constexpr int MAX_SCOPE_CHANNELS() { return 16; }
+
+/**
+ * Highest sample rate capture buffers are sized for up front. Higher rates are
+ * supported, at the cost of an allocation in prepareToPlay.
+ *
+ * \return constexpr double Max preallocated sample rate.
+ */
+static constexpr double MAX_PREALLOCATED_SAMPLE_RATE() { return 192000.; }
+
+/**
+ * Largest block size capture buffers are sized for up front. Larger blocks are
+ * supported, at the cost of an allocation in prepareToPlay.
+ *
+ * \return constexpr int Max preallocated block size.
+ */
+static constexpr int MAX_PREALLOCATED_BLOCK_SIZE() { return 8192; }
\ No newline at end of file
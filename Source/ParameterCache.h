@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    ParameterCache.h
+    Created: 18 Oct 2026 5:48:36pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+/**
+ * Typed copy of every plugin parameter, taken at once.
+ *
+ * Hot paths take one snapshot per audio block or editor frame and read it
+ * thereafter, so that all their decisions for that block or frame are based on
+ * the same values.
+ */
+struct ParameterSnapshot
+{
+  bool drawGrid = false;         /**< Whether to draw the grid */
+  float bufferLength = 0.2f;     /**< Displayed window in seconds */
+  bool isProfessional = false;   /**< Whether the professional view is shown */
+  bool isTriggered = false;      /**< Whether to acquire triggered frames */
+  bool isFallingSlope = false;   /**< Whether to trigger on decrescent slope */
+  bool isAutoTriggered = false;  /**< Whether the level is relative to the signal peak */
+  float triggerLevel = 0.2f;     /**< Trigger level */
+  float decayTime = 0.2f;        /**< Relative decay time */
+  bool muteOutput = false;       /**< Whether to mute the output */
+  float triggerPosition = 0.1f;  /**< Fraction of each acquisition taken before the crossing */
+  float holdoffTime = 0.f;       /**< Minimum time between two triggers in seconds */
+  bool backgroundRender = false; /**< Whether traces are rendered by a background thread */
+  bool persistence = false;      /**< Whether traces are accumulated like an analog phosphor */
+  int resampler = 0;             /**< Display resampler engine, index of DisplayResampler::Engine */
+  int displayMode = 0;           /**< Displayed view, index of DisplayModeListener::Mode */
+  int fftSize = 2;               /**< FFT size of the spectrum, index from 1024 points */
+  int fftWindow = 0;             /**< Window of the spectrum, index of SpectrumWorker::Window */
+  int spectrumAveraging = 1;     /**< Averaging time of the spectrum, index from none to slow */
+};
+
+/**
+ * Lock-free access to the parameters of an AudioProcessorValueTreeState.
+ *
+ * Every parameter is resolved once to its std::atomic<float> through
+ * getRawParameterValue, so taking a snapshot involves no string hashing,
+ * ValueTree traversal or juce::var conversion and is safe from any thread.
+ */
+class ParameterCache
+{
+public:
+  /**
+   * Construct a new Parameter Cache object. Must be called after every
+   * parameter was added to treeState.
+   *
+   * \param treeState TreeState holding the parameters.
+   */
+  ParameterCache(juce::AudioProcessorValueTreeState &treeState)
+      : drawGrid(resolve(treeState, "drawGrid")),
+        bufferLength(resolve(treeState, "bufferLength")),
+        isProfessional(resolve(treeState, "isProfessional")),
+        isTriggered(resolve(treeState, "isTriggered")),
+        slopeButtonTriggered(resolve(treeState, "slopeButtonTriggered")),
+        autoTriggered(resolve(treeState, "autoTriggered")),
+        triggerLevel(resolve(treeState, "triggerLevel")),
+        decayTime(resolve(treeState, "decayTime")),
+        muteOutput(resolve(treeState, "muteOutput")),
+        triggerPosition(resolve(treeState, "triggerPosition")),
+        holdoffTime(resolve(treeState, "holdoffTime")),
+        backgroundRender(resolve(treeState, "backgroundRender")),
+        persistence(resolve(treeState, "persistence")),
+        resampler(resolve(treeState, "resampler")),
+        displayMode(resolve(treeState, "displayMode")),
+        fftSize(resolve(treeState, "fftSize")),
+        fftWindow(resolve(treeState, "fftWindow")),
+        spectrumAveraging(resolve(treeState, "spectrumAveraging"))
+  {
+  }
+
+  /**
+   * Takes a snapshot of every parameter. Safe from any thread.
+   *
+   * \return ParameterSnapshot Current parameter values.
+   */
+  ParameterSnapshot getSnapshot() const
+  {
+    ParameterSnapshot snapshot;
+    snapshot.drawGrid = isOn(drawGrid);
+    snapshot.bufferLength = bufferLength->load(std::memory_order_relaxed);
+    snapshot.isProfessional = isOn(isProfessional);
+    snapshot.isTriggered = isOn(isTriggered);
+    snapshot.isFallingSlope = isOn(slopeButtonTriggered);
+    snapshot.isAutoTriggered = isOn(autoTriggered);
+    snapshot.triggerLevel = triggerLevel->load(std::memory_order_relaxed);
+    snapshot.decayTime = decayTime->load(std::memory_order_relaxed);
+    snapshot.muteOutput = isOn(muteOutput);
+    snapshot.triggerPosition = triggerPosition->load(std::memory_order_relaxed);
+    snapshot.holdoffTime = holdoffTime->load(std::memory_order_relaxed);
+    snapshot.backgroundRender = isOn(backgroundRender);
+    snapshot.persistence = isOn(persistence);
+    snapshot.resampler = (int)resampler->load(std::memory_order_relaxed);
+    snapshot.displayMode = (int)displayMode->load(std::memory_order_relaxed);
+    snapshot.fftSize = (int)fftSize->load(std::memory_order_relaxed);
+    snapshot.fftWindow = (int)fftWindow->load(std::memory_order_relaxed);
+    snapshot.spectrumAveraging = (int)spectrumAveraging->load(std::memory_order_relaxed);
+    return snapshot;
+  }
+
+private:
+  /**
+   * Resolves a parameter to its raw value.
+   *
+   * \param treeState TreeState holding the parameter.
+   * \param parameterID Parameter ID.
+   * \return std::atomic<float>* Raw value of the parameter.
+   */
+  static std::atomic<float> *resolve(juce::AudioProcessorValueTreeState &treeState, const juce::String &parameterID)
+  {
+    auto value = treeState.getRawParameterValue(parameterID);
+    jassert(value != nullptr); // unknown parameter ID
+    return value;
+  }
+
+  /**
+   * Reads a boolean parameter.
+   *
+   * \param value Raw value of the parameter.
+   * \return true if the parameter is on.
+   * \return false otherwise.
+   */
+  static bool isOn(const std::atomic<float> *value)
+  {
+    return value->load(std::memory_order_relaxed) > 0.5f;
+  }
+
+  std::atomic<float> *drawGrid;
+  std::atomic<float> *bufferLength;
+  std::atomic<float> *isProfessional;
+  std::atomic<float> *isTriggered;
+  std::atomic<float> *slopeButtonTriggered;
+  std::atomic<float> *autoTriggered;
+  std::atomic<float> *triggerLevel;
+  std::atomic<float> *decayTime;
+  std::atomic<float> *muteOutput;
+  std::atomic<float> *triggerPosition;
+  std::atomic<float> *holdoffTime;
+  std::atomic<float> *backgroundRender;
+  std::atomic<float> *persistence;
+  std::atomic<float> *resampler;
+  std::atomic<float> *displayMode;
+  std::atomic<float> *fftSize;
+  std::atomic<float> *fftWindow;
+  std::atomic<float> *spectrumAveraging;
+};
@@ -17,6 +17,7 @@ OscilloscopeAudioProcessor::OscilloscopeAudioProcessor()
 #if !JucePlugin_IsMidiEffect
 #if !JucePlugin_IsSynth
               .withInput("Input", juce::AudioChannelSet::stereo(), true)
+              .withInput("Sidechain", juce::AudioChannelSet::stereo(), false)
 #endif
               .withOutput("Output", juce::AudioChannelSet::stereo(), true)
 #endif
@@ -29,7 +30,15 @@ OscilloscopeAudioProcessor::OscilloscopeAudioProcessor()
               std::make_unique<juce::AudioParameterBool>("drawGrid",
                                                          "Draw Grid", false),
               std::make_unique<juce::AudioParameterFloat>(
-                  "bufferLength", "Scope Length", 0.05, 1, 0.2),
+                  "bufferLength", "Scope Length",
+                  []()
+                  {
+                    juce::NormalisableRange<float> range(
+                        OSCILLOSCOPE_MIN_LENGTH(), OSCILLOSCOPE_MAX_LENGTH());
+                    range.setSkewForCentre(OSCILLOSCOPE_MAX_RAW_LENGTH());
+                    return range;
+                  }(),
+                  0.2),
               std::make_unique<juce::AudioParameterBool>(
                   "isProfessional", "Professional View", false),
               std::make_unique<juce::AudioParameterBool>("isTriggered",
@@ -44,18 +53,48 @@ OscilloscopeAudioProcessor::OscilloscopeAudioProcessor()
                   "decayTime", "Decay Time", 0.05, 1, static_cast<float>(0.2)),
               std::make_unique<juce::AudioParameterBool>("muteOutput", "Mute",
                                                          false),
-
-          }) {
+              std::make_unique<juce::AudioParameterFloat>(
+                  "triggerPosition", "Pre-Trigger", 0, 1, 0.1),
+              std::make_unique<juce::AudioParameterFloat>(
+                  "holdoffTime", "Holdoff", 0, OSCILLOSCOPE_MAX_HOLDOFF_TIME(),
+                  0),
+              std::make_unique<juce::AudioParameterBool>(
+                  "backgroundRender", "Background Rendering", false),
+              std::make_unique<juce::AudioParameterBool>("persistence",
+                                                         "Persistence", false),
+              std::make_unique<juce::AudioParameterChoice>(
+                  "resampler", "Resampler",
+                  juce::StringArray{"Linear", "Cubic", "Sinc"}, 0),
+              std::make_unique<juce::AudioParameterChoice>(
+                  "displayMode", "Display Mode",
+                  juce::StringArray{"Scope", "Spectrum", "Spectrogram", "XY",
+                                    "Goniometer"},
+                  0),
+              std::make_unique<juce::AudioParameterChoice>(
+                  "fftSize", "FFT Size",
+                  juce::StringArray{"1024", "2048", "4096", "8192", "16384",
+                                    "32768", "65536"},
+                  2),
+              std::make_unique<juce::AudioParameterChoice>(
+                  "fftWindow", "FFT Window",
+                  juce::StringArray{"Hann", "Blackman-Harris", "Flat Top"}, 0),
+              std::make_unique<juce::AudioParameterChoice>(
+                  "spectrumAveraging", "Averaging",
+                  juce::StringArray{"Off", "Fast", "Medium", "Slow"}, 1),
+
+          }),
+      parameterCache(processorTreeState) {
   // Mute output if on Android (avoid feedback)
   if (juce::SystemStats::getOperatingSystemType() ==
       juce::SystemStats::OperatingSystemType::Android) {
     processorTreeState.getParameter("muteOutput")->setValueNotifyingHost(true);
   }
 
-  // reset pointers
-  audioBufferQueue.reset(
-      new AudioBufferQueue<float>(44100, getEditorRefreshRate()));
-  scopeDataCollector.reset(new ScopeDataCollector(*audioBufferQueue.get()));
+  // allocate capture buffers for the highest rate & block size up front
+  auto capacity = getCaptureGeometry(MAX_PREALLOCATED_SAMPLE_RATE(),
+                                     MAX_PREALLOCATED_BLOCK_SIZE());
+  captureResources.reset(new CaptureResources<float>(
+      getCaptureGeometry(44100, 441), capacity));
 }
 
 OscilloscopeAudioProcessor::~OscilloscopeAudioProcessor() {}
@@ -129,10 +168,26 @@ void OscilloscopeAudioProcessor::prepareToPlay(double sampleRate,
   // store sample rate
   this->sampleRate = sampleRate;
 
-  // reset pointers
-  audioBufferQueue.reset(new AudioBufferQueue<float>(
-      sampleRate, getEditorRefreshRate(), samplesPerBlock));
-  scopeDataCollector.reset(new ScopeDataCollector(*audioBufferQueue.get()));
+  // publish the new geometry, buffers are reused when large enough
+  auto geometry = getCaptureGeometry(sampleRate, samplesPerBlock);
+  captureResources->prepare(geometry);
+
+  // record the same channels
+  recorder.prepare(sampleRate, geometry.numChannels);
+}
+
+CaptureResources<float>::Geometry
+OscilloscopeAudioProcessor::getCaptureGeometry(double newSampleRate,
+                                               int samplesPerBlock) {
+  // capture every input channel, sidechain included
+  CaptureResources<float>::Geometry geometry;
+  geometry.sampleRate = newSampleRate;
+  geometry.blockSize = samplesPerBlock;
+  geometry.numChannels =
+      juce::jlimit(1, MAX_SCOPE_CHANNELS(), getTotalNumInputChannels());
+  // the editor consumes whatever arrived, at least at its idle rate
+  geometry.framesPerSecond = EDITOR_IDLE_RATE();
+  return geometry;
 }
 
 void OscilloscopeAudioProcessor::releaseResources() {}
@@ -144,18 +199,21 @@ bool OscilloscopeAudioProcessor::isBusesLayoutSupported(
   juce::ignoreUnused(layouts);
   return true;
 #else
-  // This is the place where you check if the layout is supported.
-  // In this template code we only support mono or stereo.
-  // Some plugin hosts, such as certain GarageBand versions, will only
-  // load plugins that support stereo bus layouts.
-  if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono() &&
-      layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+  // Any layout from mono up to MAX_SCOPE_CHANNELS() channels is supported,
+  // e.g. stereo, 5.1 or 7.1.4.
+  auto numOutputChannels = layouts.getMainOutputChannelSet().size();
+  if (numOutputChannels < 1 || numOutputChannels > MAX_SCOPE_CHANNELS())
     return false;
 
     // This checks if the input layout matches the output layout
 #if !JucePlugin_IsSynth
   if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
     return false;
+
+  // The sidechain, when enabled, is scoped as well
+  if (layouts.inputBuses.size() > 1 &&
+      layouts.getChannelSet(true, 1).size() > MAX_SCOPE_CHANNELS())
+    return false;
 #endif
 
   return true;
@@ -166,20 +224,53 @@ bool OscilloscopeAudioProcessor::isBusesLayoutSupported(
 void OscilloscopeAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                                               juce::MidiBuffer &midiMessages) {
   juce::ScopedNoDenormals noDenormals;
+  auto startTicks = juce::Time::getHighResolutionTicks();
   auto totalNumInputChannels = getTotalNumInputChannels();
   auto totalNumOutputChannels = getTotalNumOutputChannels();
 
   for (int i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
     buffer.clear(i, 0, buffer.getNumSamples());
 
-  // collect data to plot
-  scopeDataCollector->process(buffer.getReadPointer(0),
-                              (size_t)buffer.getNumSamples());
+  // read every parameter & the capture buffers once for this block
+  auto parameters = parameterCache.getSnapshot();
+  auto &capture = captureResources->getAudioState();
+  auto &collector = capture.buffers->collector;
+
+  // update trigger settings
+  collector.setTriggerSettings(
+      parameters.isTriggered, parameters.triggerLevel,
+      parameters.isFallingSlope, parameters.isAutoTriggered,
+      (size_t)(parameters.bufferLength * sampleRate),
+      parameters.triggerPosition,
+      (size_t)(parameters.holdoffTime * sampleRate));
+
+  // stop queueing silence once it filled any window drawn from raw samples
+  collector.setSilenceHold(
+      (size_t)(OSCILLOSCOPE_MAX_RAW_LENGTH() * capture.geometry.sampleRate));
+
+  // collect data to plot, from every input channel
+  auto numTriggersBefore = collector.getNumTriggers();
+  auto numDropped = collector.process(
+      buffer.getArrayOfReadPointers(),
+      std::min(totalNumInputChannels, capture.geometry.numChannels),
+      (size_t)buffer.getNumSamples());
+
+  // hand the same channels to the disk recorder, a no-op unless recording
+  recorder.push(buffer.getArrayOfReadPointers(),
+                std::min(totalNumInputChannels, capture.geometry.numChannels),
+                buffer.getNumSamples());
 
   // mute output if needed
-  if (processorTreeState.getParameterAsValue("muteOutput").getValue()) {
+  if (parameters.muteOutput) {
     buffer.applyGain(0);
   }
+
+  // record what this block cost
+  statistics.recordBlock(
+      juce::Time::highResolutionTicksToSeconds(
+          juce::Time::getHighResolutionTicks() - startTicks),
+      buffer.getNumSamples(), capture.geometry.sampleRate, numDropped,
+      (size_t)(collector.getNumTriggers() - numTriggersBefore));
 }
 
 //==============================================================================
@@ -224,14 +315,26 @@ void OscilloscopeAudioProcessor::setStateInformation(const void *data,
 
 int OscilloscopeAudioProcessor::getSampleRate() { return this->sampleRate; }
 
-AudioBufferQueue<float> *OscilloscopeAudioProcessor::getAudioBufferQueue() {
-  return this->audioBufferQueue.get();
+CaptureResources<float> &OscilloscopeAudioProcessor::getCaptureResources() {
+  return *this->captureResources;
 }
 
 juce::AudioProcessorValueTreeState *OscilloscopeAudioProcessor::getTreeState() {
   return &this->processorTreeState;
 }
 
+const ParameterCache &OscilloscopeAudioProcessor::getParameterCache() const {
+  return this->parameterCache;
+}
+
+ProcessingStatistics &OscilloscopeAudioProcessor::getStatistics() {
+  return this->statistics;
+}
+
+CaptureRecorder &OscilloscopeAudioProcessor::getRecorder() {
+  return this->recorder;
+}
+
 //==============================================================================
 // This creates new instances of the plugin..
 juce::AudioProcessor *JUCE_CALLTYPE createPluginFilter() {
@@ -266,6 +369,6 @@ int OscilloscopeAudioProcessor::getEditorRefreshRate() {
   auto rate = processorTreeState.state.getOrCreateChildWithName(
       "editorRefreshRate", nullptr);
 
-  // store property value
-  return rate.getProperty("height", EDITOR_INITIAL_RATE());
+  // get and return property value
+  return rate.getProperty("rate", EDITOR_MAX_RATE());
 }
@@ -10,8 +10,10 @@
 
 #include <JuceHeader.h>
 #include "InitVariables.h"
-#include "Buffers/ScopeDataCollector.h"
-#include "Buffers/AudioBufferQueue.h"
+#include "ParameterCache.h"
+#include "ProcessingStatistics.h"
+#include "CaptureRecorder.h"
+#include "Buffers/CaptureResources.h"
 
 //==============================================================================
 /**
@@ -147,11 +149,12 @@ public:
   int getSampleRate();
 
   /**
-   * Get the AudioBufferQueue object
+   * Get the CaptureResources object. The editor reads the capture buffers
+   * through it.
    *
-   * \return AudioBufferQueue<float>* Audio Buffer Queue object.
+   * \return CaptureResources<float>& Capture buffers shared with the audio thread.
    */
-  AudioBufferQueue<float> *getAudioBufferQueue();
+  CaptureResources<float> &getCaptureResources();
 
   /**
    * Get the TreeState object
@@ -160,6 +163,27 @@ public:
    */
   juce::AudioProcessorValueTreeState *getTreeState();
 
+  /**
+   * Get the ParameterCache object
+   *
+   * \return const ParameterCache& Lock-free access to the parameters.
+   */
+  const ParameterCache &getParameterCache() const;
+
+  /**
+   * Get the ProcessingStatistics object
+   *
+   * \return ProcessingStatistics& Audio thread cost & data loss counters.
+   */
+  ProcessingStatistics &getStatistics();
+
+  /**
+   * Get the CaptureRecorder object
+   *
+   * \return CaptureRecorder& Recorder of the captured channels to disk.
+   */
+  CaptureRecorder &getRecorder();
+
   /**
    * Get editor width.
    *
@@ -182,9 +206,9 @@ public:
   void storeEditorSize(int width, int height);
 
   /**
-   * Get the stored refresh rate.
+   * Get the stored maximum refresh rate of the editor.
    *
-   * \return Stored editors' refresh rate.
+   * \return Stored editors' maximum refresh rate.
    */
   int getEditorRefreshRate();
 
@@ -197,9 +221,21 @@ private:
   void resetAllValuesToDefault(juce::ValueTree tree);
 
   //==============================================================================
-  std::unique_ptr<AudioBufferQueue<float>> audioBufferQueue;
-  std::unique_ptr<ScopeDataCollector<float>> scopeDataCollector;
   juce::AudioProcessorValueTreeState processorTreeState;
+  ParameterCache parameterCache;
+  std::unique_ptr<CaptureResources<float>> captureResources;
+  ProcessingStatistics statistics;
+  CaptureRecorder recorder;
   int sampleRate = 44100;
+
+  /**
+   * Get the capture geometry of the current bus layout.
+   *
+   * \param newSampleRate Sample rate.
+   * \param samplesPerBlock Maximum samples per block.
+   * \return CaptureResources<float>::Geometry Geometry to capture with.
+   */
+  CaptureResources<float>::Geometry getCaptureGeometry(double newSampleRate, int samplesPerBlock);
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OscilloscopeAudioProcessor)
 };
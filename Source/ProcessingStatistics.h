@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    ProcessingStatistics.h
+    Created: 18 Oct 2026 8:31:17pm
+    Author:  wadda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <limits>
+
+/**
+ * Copy of every counter of ProcessingStatistics, taken at once.
+ */
+struct StatisticsSnapshot
+{
+  static constexpr int numLoadBuckets = 8; /**< Number of histogram buckets */
+
+  juce::uint64 numBlocks = 0;          /**< Processed audio blocks */
+  juce::uint64 numSamples = 0;         /**< Processed samples per channel */
+  double totalSeconds = 0.;            /**< Time spent in processBlock */
+  double maxBlockSeconds = 0.;         /**< Longest processBlock call */
+  juce::uint64 numDroppedSamples = 0;  /**< Samples the AudioBufferQueue had no room for */
+  juce::uint64 numEmptyPops = 0;       /**< Editor frames without a complete frame of samples ready */
+  juce::uint64 numTriggers = 0;        /**< Published triggered acquisitions */
+  double sampleRate = 44100.;          /**< Sample rate of the last block */
+
+  std::array<juce::uint64, numLoadBuckets> loadHistogram{}; /**< Blocks per bucket of processing time over block duration */
+
+  /**
+   * Get the upper bound of a histogram bucket.
+   *
+   * \param bucket Bucket index.
+   * \return double Processing time over block duration below which blocks fall in the bucket.
+   */
+  static double getLoadBucketLimit(int bucket)
+  {
+    static constexpr double limits[numLoadBuckets] = {0.01, 0.02, 0.05, 0.1, 0.25, 0.5, 1., std::numeric_limits<double>::infinity()};
+    return limits[bucket];
+  }
+
+  /**
+   * Get the average share of the real-time budget used by processBlock.
+   *
+   * \return double Processing time over audio duration.
+   */
+  double getAverageLoad() const
+  {
+    return numSamples == 0 ? 0. : totalSeconds * sampleRate / double(numSamples);
+  }
+
+  /**
+   * Get the average number of triggers per second of audio.
+   *
+   * \return double Trigger rate in Hz.
+   */
+  double getTriggerRate() const
+  {
+    return numSamples == 0 ? 0. : double(numTriggers) * sampleRate / double(numSamples);
+  }
+};
+
+/**
+ * Lock-free counters of what the scope costs on the audio thread and of where
+ * data gets lost between the audio and GUI threads.
+ *
+ * The audio thread records each block with relaxed atomic increments, any
+ * thread can take a snapshot.
+ */
+class ProcessingStatistics
+{
+public:
+  /**
+   * Records a processed block. To be called from the audio thread.
+   *
+   * \param seconds Time spent processing the block.
+   * \param numBlockSamples Samples per channel in the block.
+   * \param sampleRate Sample rate.
+   * \param numDropped Samples the AudioBufferQueue had no room for.
+   * \param numNewTriggers Triggered acquisitions published during the block.
+   */
+  void recordBlock(double seconds, int numBlockSamples, double sampleRate, size_t numDropped, size_t numNewTriggers)
+  {
+    numBlocks.fetch_add(1, std::memory_order_relaxed);
+    numSamples.fetch_add((juce::uint64)numBlockSamples, std::memory_order_relaxed);
+    totalNanoseconds.fetch_add((juce::uint64)(seconds * 1.0e9), std::memory_order_relaxed);
+    numDroppedSamples.fetch_add(numDropped, std::memory_order_relaxed);
+    numTriggers.fetch_add(numNewTriggers, std::memory_order_relaxed);
+    lastSampleRate.store(sampleRate, std::memory_order_relaxed);
+
+    // only the audio thread writes the maximum
+    auto nanoseconds = (juce::uint64)(seconds * 1.0e9);
+    if (nanoseconds > maxBlockNanoseconds.load(std::memory_order_relaxed))
+    {
+      maxBlockNanoseconds.store(nanoseconds, std::memory_order_relaxed);
+    }
+
+    // share of the block duration
+    auto load = numBlockSamples > 0 ? seconds * sampleRate / numBlockSamples : 0.;
+    int bucket = 0;
+    while (load >= StatisticsSnapshot::getLoadBucketLimit(bucket))
+    {
+      ++bucket;
+    }
+    loadHistogram[(size_t)bucket].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Records an editor frame without a complete frame of samples ready. To be
+   * called from the message thread.
+   *
+   */
+  void recordEmptyPop()
+  {
+    numEmptyPops.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Takes a snapshot of every counter. Safe from any thread.
+   *
+   * \return StatisticsSnapshot Current counters.
+   */
+  StatisticsSnapshot getSnapshot() const
+  {
+    StatisticsSnapshot snapshot;
+    snapshot.numBlocks = numBlocks.load(std::memory_order_relaxed);
+    snapshot.numSamples = numSamples.load(std::memory_order_relaxed);
+    snapshot.totalSeconds = (double)totalNanoseconds.load(std::memory_order_relaxed) * 1.0e-9;
+    snapshot.maxBlockSeconds = (double)maxBlockNanoseconds.load(std::memory_order_relaxed) * 1.0e-9;
+    snapshot.numDroppedSamples = numDroppedSamples.load(std::memory_order_relaxed);
+    snapshot.numEmptyPops = numEmptyPops.load(std::memory_order_relaxed);
+    snapshot.numTriggers = numTriggers.load(std::memory_order_relaxed);
+    snapshot.sampleRate = lastSampleRate.load(std::memory_order_relaxed);
+    for (size_t bucket = 0; bucket < loadHistogram.size(); ++bucket)
+    {
+      snapshot.loadHistogram[bucket] = loadHistogram[bucket].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+  }
+
+private:
+  std::atomic<juce::uint64> numBlocks{0};           /**< Processed audio blocks */
+  std::atomic<juce::uint64> numSamples{0};          /**< Processed samples per channel */
+  std::atomic<juce::uint64> totalNanoseconds{0};    /**< Time spent in processBlock */
+  std::atomic<juce::uint64> maxBlockNanoseconds{0}; /**< Longest processBlock call */
+  std::atomic<juce::uint64> numDroppedSamples{0};   /**< Samples the AudioBufferQueue had no room for */
+  std::atomic<juce::uint64> numEmptyPops{0};        /**< Editor frames without new samples */
+  std::atomic<juce::uint64> numTriggers{0};         /**< Published triggered acquisitions */
+  std::atomic<double> lastSampleRate{44100.};       /**< Sample rate of the last block */
+
+  std::array<std::atomic<juce::uint64>, StatisticsSnapshot::numLoadBuckets> loadHistogram{}; /**< Blocks per load bucket */
+};